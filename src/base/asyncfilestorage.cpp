@@ -59,6 +59,12 @@ void AsyncFileStorage::store(const QString &fileName, const QByteArray &data)
                               , Qt::QueuedConnection);
 }
 
+void AsyncFileStorage::append(const QString &fileName, const QByteArray &data)
+{
+    QMetaObject::invokeMethod(this, [this, data, fileName]() { append_impl(fileName, data); }
+                              , Qt::QueuedConnection);
+}
+
 QDir AsyncFileStorage::storageDir() const
 {
     return m_storageDir;
@@ -79,3 +85,16 @@ void AsyncFileStorage::store_impl(const QString &fileName, const QByteArray &dat
         }
     }
 }
+
+void AsyncFileStorage::append_impl(const QString &fileName, const QByteArray &data)
+{
+    const QString filePath = m_storageDir.absoluteFilePath(fileName);
+    QFile file(filePath);
+    qDebug() << "AsyncFileStorage: Appending data to" << filePath;
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)
+        || (file.write(data) != data.size()) || !file.flush())
+    {
+        qDebug() << "AsyncFileStorage: Failed to append data";
+        emit failed(filePath, file.errorString());
+    }
+}
@@ -72,12 +72,14 @@ HEADERS += \
     $$PWD/search/searchdownloadhandler.h \
     $$PWD/search/searchhandler.h \
     $$PWD/search/searchpluginmanager.h \
+    $$PWD/search/searchresultstore.h \
     $$PWD/settingsstorage.h \
     $$PWD/settingvalue.h \
     $$PWD/tagset.h \
     $$PWD/torrentfileguard.h \
     $$PWD/torrentfileswatcher.h \
     $$PWD/torrentfilter.h \
+    $$PWD/torrentfilterindex.h \
     $$PWD/types.h \
     $$PWD/unicodestrings.h \
     $$PWD/utils/bytearray.h \
@@ -111,6 +113,7 @@ SOURCES += \
     $$PWD/bittorrent/peeraddress.cpp \
     $$PWD/bittorrent/peerinfo.cpp \
     $$PWD/bittorrent/portforwarderimpl.cpp \
+    $$PWD/bittorrent/resumedatastorage.cpp \
     $$PWD/bittorrent/session.cpp \
     $$PWD/bittorrent/speedmonitor.cpp \
     $$PWD/bittorrent/statistics.cpp \
@@ -152,11 +155,13 @@ SOURCES += \
     $$PWD/search/searchdownloadhandler.cpp \
     $$PWD/search/searchhandler.cpp \
     $$PWD/search/searchpluginmanager.cpp \
+    $$PWD/search/searchresultstore.cpp \
     $$PWD/settingsstorage.cpp \
     $$PWD/tagset.cpp \
     $$PWD/torrentfileguard.cpp \
     $$PWD/torrentfileswatcher.cpp \
     $$PWD/torrentfilter.cpp \
+    $$PWD/torrentfilterindex.cpp \
     $$PWD/utils/bytearray.cpp \
     $$PWD/utils/compare.cpp \
     $$PWD/utils/foreignapps.cpp \
@@ -38,6 +38,7 @@
 #include <QByteArray>
 #include <QRegularExpression>
 #include <QSaveFile>
+#include <QSet>
 #include <QThread>
 
 #include "base/algorithm.h"
@@ -62,12 +63,14 @@ namespace BitTorrent
     public:
         explicit Worker(const QDir &resumeDataDir);
 
-        void store(const TorrentID &id, const LoadTorrentParams &resumeData) const;
-        void remove(const TorrentID &id) const;
+        void store(const TorrentID &id, const LoadTorrentParams &resumeData);
+        void remove(const TorrentID &id);
         void storeQueue(const QVector<TorrentID> &queue) const;
 
     private:
         const QDir m_resumeDataDir;
+        // Metadata never changes once it is received so it is written only once
+        QSet<TorrentID> m_storedMetadata;
     };
 }
 
@@ -146,6 +149,33 @@ QVector<BitTorrent::TorrentID> BitTorrent::BencodeResumeDataStorage::registeredT
 }
 
 std::optional<BitTorrent::LoadTorrentParams> BitTorrent::BencodeResumeDataStorage::load(const TorrentID &id) const
+{
+    QByteArray data;
+    QByteArray metadata;
+    if (!readResumeData(id, data, metadata))
+        return std::nullopt;
+
+    return loadTorrentResumeData(data, TorrentInfo::load(metadata));
+}
+
+void BitTorrent::BencodeResumeDataStorage::readAll(const ReadResumeDataHandler &handler) const
+{
+    for (const TorrentID &id : m_registeredTorrents)
+    {
+        QByteArray data;
+        QByteArray metadata;
+        const bool isRead = readResumeData(id, data, metadata);
+        handler(id, [this, isRead, data, metadata]() -> std::optional<LoadTorrentParams>
+        {
+            if (!isRead)
+                return std::nullopt;
+
+            return loadTorrentResumeData(data, TorrentInfo::load(metadata));
+        });
+    }
+}
+
+bool BitTorrent::BencodeResumeDataStorage::readResumeData(const TorrentID &id, QByteArray &data, QByteArray &metadata) const
 {
     const QString idString = id.toString();
     const QString fastresumePath = m_resumeDataDir.absoluteFilePath(QString::fromLatin1("%1.fastresume").arg(idString));
@@ -155,13 +185,17 @@ std::optional<BitTorrent::LoadTorrentParams> BitTorrent::BencodeResumeDataStorag
     if (!file.open(QIODevice::ReadOnly))
     {
         LogMsg(tr("Cannot read file %1: %2").arg(fastresumePath, file.errorString()), Log::WARNING);
-        return std::nullopt;
+        return false;
     }
 
-    const QByteArray data = file.readAll();
-    const TorrentInfo metadata = TorrentInfo::loadFromFile(torrentFilePath);
+    data = file.readAll();
 
-    return loadTorrentResumeData(data, metadata);
+    // metadata is optional, torrent can be loaded without it
+    QFile torrentFile {torrentFilePath};
+    if ((torrentFile.size() <= MAX_TORRENT_SIZE) && torrentFile.open(QIODevice::ReadOnly))
+        metadata = torrentFile.readAll();
+
+    return true;
 }
 
 std::optional<BitTorrent::LoadTorrentParams> BitTorrent::BencodeResumeDataStorage::loadTorrentResumeData(
@@ -308,7 +342,7 @@ BitTorrent::BencodeResumeDataStorage::Worker::Worker(const QDir &resumeDataDir)
 {
 }
 
-void BitTorrent::BencodeResumeDataStorage::Worker::store(const TorrentID &id, const LoadTorrentParams &resumeData) const
+void BitTorrent::BencodeResumeDataStorage::Worker::store(const TorrentID &id, const LoadTorrentParams &resumeData)
 {
     // We need to adjust native libtorrent resume data
     lt::add_torrent_params p = resumeData.ltAddTorrentParams;
@@ -334,10 +368,14 @@ void BitTorrent::BencodeResumeDataStorage::Worker::store(const TorrentID &id, co
     }
 
     // metadata is stored in separate .torrent file
+    // and doesn't need to be written again if it is already stored
     const std::shared_ptr<lt::torrent_info> torrentInfo = std::move(p.ti);
-    if (torrentInfo)
+    const QString torrentFilepath = m_resumeDataDir.absoluteFilePath(QString::fromLatin1("%1.torrent").arg(id.toString()));
+    if (torrentInfo && !m_storedMetadata.contains(id) && QFile::exists(torrentFilepath))
+        m_storedMetadata.insert(id);
+
+    if (torrentInfo && !m_storedMetadata.contains(id))
     {
-        const QString torrentFilepath = m_resumeDataDir.absoluteFilePath(QString::fromLatin1("%1.torrent").arg(id.toString()));
         try
         {
             const auto torrentCreator = lt::create_torrent(*torrentInfo);
@@ -356,6 +394,8 @@ void BitTorrent::BencodeResumeDataStorage::Worker::store(const TorrentID &id, co
                    .arg(torrentFilepath, QString::fromLocal8Bit(err.what())), Log::CRITICAL);
             return;
         }
+
+        m_storedMetadata.insert(id);
     }
 
     lt::entry data = lt::write_resume_data(p);
@@ -382,8 +422,10 @@ void BitTorrent::BencodeResumeDataStorage::Worker::store(const TorrentID &id, co
     }
 }
 
-void BitTorrent::BencodeResumeDataStorage::Worker::remove(const TorrentID &id) const
+void BitTorrent::BencodeResumeDataStorage::Worker::remove(const TorrentID &id)
 {
+    m_storedMetadata.remove(id);
+
     const QString resumeFilename = QString::fromLatin1("%1.fastresume").arg(id.toString());
     Utils::Fs::forceRemove(m_resumeDataDir.absoluteFilePath(resumeFilename));
 
@@ -56,7 +56,9 @@ namespace BitTorrent
         void storeQueue(const QVector<TorrentID> &queue) const override;
 
     private:
+        void readAll(const ReadResumeDataHandler &handler) const override;
         void loadQueue(const QString &queueFilename);
+        bool readResumeData(const TorrentID &id, QByteArray &data, QByteArray &metadata) const;
         std::optional<LoadTorrentParams> loadTorrentResumeData(const QByteArray &data, const TorrentInfo &metadata) const;
 
         const QDir m_resumeDataDir;
@@ -28,6 +28,9 @@
 
 #include "dbresumedatastorage.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <libtorrent/bdecode.hpp>
 #include <libtorrent/bencode.hpp>
 #include <libtorrent/create_torrent.hpp>
@@ -36,12 +39,17 @@
 #include <libtorrent/write_resume_data.hpp>
 
 #include <QByteArray>
+#include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QHash>
 #include <QSet>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QSqlRecord>
 #include <QThread>
+#include <QTimer>
 #include <QVector>
 
 #include "base/exceptions.h"
@@ -57,9 +65,15 @@
 namespace
 {
     const char DB_CONNECTION_NAME[] = "ResumeDataStorage";
+    const char DB_LOADER_CONNECTION_NAME[] = "ResumeDataStorageLoader";
 
     const int DB_VERSION = 1;
 
+    // Interval during which the changes are merged before writing them to database
+    const int FLUSH_INTERVAL = 500; // ms
+    // Failed flush is retried with increasing interval up to this limit
+    const int MAX_FLUSH_RETRY_INTERVAL = 60 * 1000; // ms
+
     const char DB_TABLE_META[] = "meta";
     const char DB_TABLE_TORRENTS[] = "torrents";
 
@@ -152,6 +166,60 @@ namespace
     {
         return QString::fromLatin1("%1 %2").arg(quoted(column.name), QLatin1String(definition));
     }
+
+    QString makeSelectTorrentStatement()
+    {
+        return QString::fromLatin1("SELECT * FROM %1 WHERE %2 = %3;")
+                .arg(quoted(DB_TABLE_TORRENTS), quoted(DB_COLUMN_TORRENT_ID.name), DB_COLUMN_TORRENT_ID.placeholder);
+    }
+
+    // Parses all the columns except of the bencoded ones
+    BitTorrent::LoadTorrentParams parseQueryResultRow(const QSqlQuery &query)
+    {
+        BitTorrent::LoadTorrentParams resumeData;
+        resumeData.restored = true;
+        resumeData.name = query.value(DB_COLUMN_NAME.name).toString();
+        resumeData.category = query.value(DB_COLUMN_CATEGORY.name).toString();
+        const QString tagsData = query.value(DB_COLUMN_TAGS.name).toString();
+        if (!tagsData.isEmpty())
+        {
+            const QStringList tagList = tagsData.split(QLatin1Char(','));
+            resumeData.tags.insert(tagList.cbegin(), tagList.cend());
+        }
+        resumeData.savePath = Profile::instance()->fromPortablePath(
+                    Utils::Fs::toUniformPath(query.value(DB_COLUMN_TARGET_SAVE_PATH.name).toString()));
+        resumeData.hasSeedStatus = query.value(DB_COLUMN_HAS_SEED_STATUS.name).toBool();
+        resumeData.firstLastPiecePriority = query.value(DB_COLUMN_HAS_OUTER_PIECES_PRIORITY.name).toBool();
+        resumeData.ratioLimit = query.value(DB_COLUMN_RATIO_LIMIT.name).toInt() / 1000.0;
+        resumeData.seedingTimeLimit = query.value(DB_COLUMN_SEEDING_TIME_LIMIT.name).toInt();
+        resumeData.contentLayout = Utils::String::toEnum<BitTorrent::TorrentContentLayout>(
+                    query.value(DB_COLUMN_CONTENT_LAYOUT.name).toString(), BitTorrent::TorrentContentLayout::Original);
+        resumeData.operatingMode = Utils::String::toEnum<BitTorrent::TorrentOperatingMode>(
+                    query.value(DB_COLUMN_OPERATING_MODE.name).toString(), BitTorrent::TorrentOperatingMode::AutoManaged);
+        resumeData.stopped = query.value(DB_COLUMN_STOPPED.name).toBool();
+
+        return resumeData;
+    }
+
+    // Decodes the bencoded columns. It is the most expensive part of loading
+    // so it doesn't access the database and can be run in any thread.
+    BitTorrent::LoadTorrentParams decodeResumeData(BitTorrent::LoadTorrentParams resumeData
+            , const QByteArray &bencodedResumeData, const QByteArray &bencodedMetadata)
+    {
+        lt::error_code ec;
+        const lt::bdecode_node root = lt::bdecode(bencodedResumeData, ec);
+
+        lt::add_torrent_params &p = resumeData.ltAddTorrentParams;
+
+        p = lt::read_resume_data(root, ec);
+        p.save_path = Profile::instance()->fromPortablePath(fromLTString(p.save_path)).toStdString();
+
+        const auto metadata = BitTorrent::TorrentInfo::load(bencodedMetadata);
+        if (metadata.isValid())
+            p.ti = metadata.nativeInfo();
+
+        return resumeData;
+    }
 }
 
 namespace BitTorrent
@@ -163,16 +231,36 @@ namespace BitTorrent
     public:
         Worker(const QString &dbPath, const QString &dbConnectionName);
 
-        void openDatabase() const;
-        void closeDatabase() const;
+        void openDatabase();
+        void closeDatabase();
 
-        void store(const TorrentID &id, const LoadTorrentParams &resumeData) const;
-        void remove(const TorrentID &id) const;
-        void storeQueue(const QVector<TorrentID> &queue) const;
+        void store(const TorrentID &id, const LoadTorrentParams &resumeData);
+        void remove(const TorrentID &id);
+        void storeQueue(const QVector<TorrentID> &queue);
 
     private:
+        void scheduleFlush();
+        void flush();
+        void handleFlushFailure(const QString &errorMessage, const QHash<TorrentID, std::optional<LoadTorrentParams>> &changes);
+        bool storeTorrent(const TorrentID &id, const LoadTorrentParams &resumeData);
+        bool removeTorrent(const TorrentID &id);
+        QSqlQuery &preparedQuery(std::optional<QSqlQuery> &query, const QString &statement) const;
+
         const QString m_path;
         const QString m_connectionName;
+
+        // Changes are collected for a while and then written in single transaction.
+        // Missing resume data means the torrent should be removed.
+        QHash<TorrentID, std::optional<LoadTorrentParams>> m_pendingChanges;
+        QTimer *m_flushTimer = nullptr;
+        // The failure is logged only once until the changes are stored successfully
+        bool m_isFlushFailed = false;
+        // Metadata never changes once it is received so it is written only once
+        QSet<TorrentID> m_storedMetadata;
+
+        std::optional<QSqlQuery> m_insertTorrentQuery;
+        std::optional<QSqlQuery> m_insertTorrentWithMetadataQuery;
+        std::optional<QSqlQuery> m_deleteTorrentQuery;
     };
 }
 
@@ -242,15 +330,11 @@ QVector<BitTorrent::TorrentID> BitTorrent::DBResumeDataStorage::registeredTorren
 
 std::optional<BitTorrent::LoadTorrentParams> BitTorrent::DBResumeDataStorage::load(const TorrentID &id) const
 {
-    const QString selectTorrentStatement =
-            QString(QLatin1String("SELECT * FROM %1 WHERE %2 = %3;"))
-            .arg(quoted(DB_TABLE_TORRENTS), quoted(DB_COLUMN_TORRENT_ID.name), DB_COLUMN_TORRENT_ID.placeholder);
-
     auto db = QSqlDatabase::database(DB_CONNECTION_NAME);
     QSqlQuery query {db};
     try
     {
-        if (!query.prepare(selectTorrentStatement))
+        if (!query.prepare(makeSelectTorrentStatement()))
             throw RuntimeError(query.lastError().text());
 
         query.bindValue(DB_COLUMN_TORRENT_ID.placeholder, id.toString());
@@ -267,44 +351,57 @@ std::optional<BitTorrent::LoadTorrentParams> BitTorrent::DBResumeDataStorage::lo
         return std::nullopt;
     }
 
-    LoadTorrentParams resumeData;
-    resumeData.restored = true;
-    resumeData.name = query.value(DB_COLUMN_NAME.name).toString();
-    resumeData.category = query.value(DB_COLUMN_CATEGORY.name).toString();
-    const QString tagsData = query.value(DB_COLUMN_TAGS.name).toString();
-    if (!tagsData.isEmpty())
+    return decodeResumeData(parseQueryResultRow(query)
+            , query.value(DB_COLUMN_RESUMEDATA.name).toByteArray()
+            , query.value(DB_COLUMN_METADATA.name).toByteArray());
+}
+
+void BitTorrent::DBResumeDataStorage::readAll(const ReadResumeDataHandler &handler) const
+{
     {
-        const QStringList tagList = tagsData.split(QLatin1Char(','));
-        resumeData.tags.insert(tagList.cbegin(), tagList.cend());
+        // The loading thread cannot use the connection of the main thread
+        auto db = QSqlDatabase::cloneDatabase(QLatin1String(DB_CONNECTION_NAME), QLatin1String(DB_LOADER_CONNECTION_NAME));
+        if (db.open())
+            readTorrents(db, handler);
+        else
+            LogMsg(tr("Couldn't load resume data of torrents. Error: %1").arg(db.lastError().text()), Log::CRITICAL);
     }
-    resumeData.savePath = Profile::instance()->fromPortablePath(
-                Utils::Fs::toUniformPath(query.value(DB_COLUMN_TARGET_SAVE_PATH.name).toString()));
-    resumeData.hasSeedStatus = query.value(DB_COLUMN_HAS_SEED_STATUS.name).toBool();
-    resumeData.firstLastPiecePriority = query.value(DB_COLUMN_HAS_OUTER_PIECES_PRIORITY.name).toBool();
-    resumeData.ratioLimit = query.value(DB_COLUMN_RATIO_LIMIT.name).toInt() / 1000.0;
-    resumeData.seedingTimeLimit = query.value(DB_COLUMN_SEEDING_TIME_LIMIT.name).toInt();
-    resumeData.contentLayout = Utils::String::toEnum<TorrentContentLayout>(
-                query.value(DB_COLUMN_CONTENT_LAYOUT.name).toString(), TorrentContentLayout::Original);
-    resumeData.operatingMode = Utils::String::toEnum<TorrentOperatingMode>(
-                query.value(DB_COLUMN_OPERATING_MODE.name).toString(), TorrentOperatingMode::AutoManaged);
-    resumeData.stopped = query.value(DB_COLUMN_STOPPED.name).toBool();
 
-    const QByteArray bencodedResumeData = query.value(DB_COLUMN_RESUMEDATA.name).toByteArray();
+    QSqlDatabase::removeDatabase(QLatin1String(DB_LOADER_CONNECTION_NAME));
+}
 
-    lt::error_code ec;
-    const lt::bdecode_node root = lt::bdecode(bencodedResumeData, ec);
+void BitTorrent::DBResumeDataStorage::readTorrents(const QSqlDatabase &db, const ReadResumeDataHandler &handler) const
+{
+    // All the torrents are read by single sequential scan in the same order as registeredTorrents() returns them
+    const auto selectAllTorrentsStatement = QString::fromLatin1("SELECT * FROM %1 ORDER BY %2;")
+            .arg(quoted(DB_TABLE_TORRENTS), quoted(DB_COLUMN_QUEUE_POSITION.name));
 
-    lt::add_torrent_params &p = resumeData.ltAddTorrentParams;
+    QSqlQuery query {db};
+    query.setForwardOnly(true);
+    if (!query.prepare(selectAllTorrentsStatement) || !query.exec())
+    {
+        LogMsg(tr("Couldn't load resume data of torrents. Error: %1").arg(query.lastError().text()), Log::CRITICAL);
+        return;
+    }
 
-    p = lt::read_resume_data(root, ec);
-    p.save_path = Profile::instance()->fromPortablePath(fromLTString(p.save_path)).toStdString();
+    const int torrentIDIndex = query.record().indexOf(DB_COLUMN_TORRENT_ID.name);
+    const int resumeDataIndex = query.record().indexOf(DB_COLUMN_RESUMEDATA.name);
+    const int metadataIndex = query.record().indexOf(DB_COLUMN_METADATA.name);
+    while (query.next())
+    {
+        const auto id = TorrentID::fromString(query.value(torrentIDIndex).toString());
+        const LoadTorrentParams resumeData = parseQueryResultRow(query);
+        const QByteArray bencodedResumeData = query.value(resumeDataIndex).toByteArray();
+        const QByteArray bencodedMetadata = query.value(metadataIndex).toByteArray();
 
-    const QByteArray bencodedMetadata = query.value(DB_COLUMN_METADATA.name).toByteArray();
-    auto metadata = TorrentInfo::load(bencodedMetadata);
-    if (metadata.isValid())
-        p.ti = metadata.nativeInfo();
+        handler(id, [resumeData, bencodedResumeData, bencodedMetadata]() -> std::optional<LoadTorrentParams>
+        {
+            return decodeResumeData(resumeData, bencodedResumeData, bencodedMetadata);
+        });
+    }
 
-    return resumeData;
+    if (query.lastError().isValid())
+        LogMsg(tr("Couldn't load resume data of torrents. Error: %1").arg(query.lastError().text()), Log::CRITICAL);
 }
 
 void BitTorrent::DBResumeDataStorage::store(const TorrentID &id, const LoadTorrentParams &resumeData) const
@@ -396,23 +493,164 @@ void BitTorrent::DBResumeDataStorage::createDB() const
 BitTorrent::DBResumeDataStorage::Worker::Worker(const QString &dbPath, const QString &dbConnectionName)
     : m_path {dbPath}
     , m_connectionName {dbConnectionName}
+    , m_flushTimer {new QTimer(this)}
 {
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FLUSH_INTERVAL);
+    connect(m_flushTimer, &QTimer::timeout, this, &Worker::flush);
 }
 
-void BitTorrent::DBResumeDataStorage::Worker::openDatabase() const
+void BitTorrent::DBResumeDataStorage::Worker::openDatabase()
 {
     auto db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), m_connectionName);
     db.setDatabaseName(m_path);
     if (!db.open())
         throw RuntimeError(db.lastError().text());
+
+    QSqlQuery query {db};
+    if (!query.exec(QLatin1String("PRAGMA journal_mode = WAL;")))
+    {
+        LogMsg(tr("Couldn't enable Write-Ahead Logging (WAL) journaling mode. Error: %1")
+            .arg(query.lastError().text()), Log::WARNING);
+    }
+
+    const auto selectStoredMetadataStatement = QString::fromLatin1("SELECT %1 FROM %2 WHERE %3 IS NOT NULL;")
+            .arg(quoted(DB_COLUMN_TORRENT_ID.name), quoted(DB_TABLE_TORRENTS), quoted(DB_COLUMN_METADATA.name));
+    if (!query.exec(selectStoredMetadataStatement))
+        throw RuntimeError(query.lastError().text());
+
+    while (query.next())
+        m_storedMetadata.insert(TorrentID::fromString(query.value(0).toString()));
 }
 
-void BitTorrent::DBResumeDataStorage::Worker::closeDatabase() const
+void BitTorrent::DBResumeDataStorage::Worker::closeDatabase()
 {
+    flush();
+
+    m_insertTorrentQuery.reset();
+    m_insertTorrentWithMetadataQuery.reset();
+    m_deleteTorrentQuery.reset();
+
     QSqlDatabase::removeDatabase(m_connectionName);
 }
 
-void BitTorrent::DBResumeDataStorage::Worker::store(const TorrentID &id, const LoadTorrentParams &resumeData) const
+void BitTorrent::DBResumeDataStorage::Worker::store(const TorrentID &id, const LoadTorrentParams &resumeData)
+{
+    m_pendingChanges[id] = resumeData;
+    scheduleFlush();
+}
+
+void BitTorrent::DBResumeDataStorage::Worker::remove(const TorrentID &id)
+{
+    m_pendingChanges[id] = std::nullopt;
+    scheduleFlush();
+}
+
+void BitTorrent::DBResumeDataStorage::Worker::scheduleFlush()
+{
+    if (!m_flushTimer->isActive())
+        m_flushTimer->start();
+}
+
+void BitTorrent::DBResumeDataStorage::Worker::flush()
+{
+    m_flushTimer->stop();
+    if (m_pendingChanges.isEmpty())
+        return;
+
+    const QHash<TorrentID, std::optional<LoadTorrentParams>> changes = std::exchange(m_pendingChanges, {});
+
+    auto db = QSqlDatabase::database(m_connectionName);
+    if (!db.transaction())
+    {
+        handleFlushFailure(db.lastError().text(), changes);
+        return;
+    }
+
+    // stored metadata is tracked only when the transaction is committed successfully
+    QVector<TorrentID> storedMetadata;
+    QVector<TorrentID> removedTorrents;
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it)
+    {
+        const TorrentID &id = it.key();
+        const std::optional<LoadTorrentParams> &resumeData = it.value();
+        if (resumeData)
+        {
+            if (storeTorrent(id, *resumeData) && resumeData->ltAddTorrentParams.ti)
+                storedMetadata.append(id);
+        }
+        else
+        {
+            if (removeTorrent(id))
+                removedTorrents.append(id);
+        }
+    }
+
+    QElapsedTimer commitTimer;
+    commitTimer.start();
+    if (!db.commit())
+    {
+        const QString errorMessage = db.lastError().text();
+        db.rollback();
+        handleFlushFailure(errorMessage, changes);
+        return;
+    }
+
+    if (m_isFlushFailed)
+    {
+        m_isFlushFailed = false;
+        m_flushTimer->setInterval(FLUSH_INTERVAL);
+        LogMsg(tr("Resume data is stored successfully again"));
+    }
+
+    for (const TorrentID &id : asConst(storedMetadata))
+        m_storedMetadata.insert(id);
+    for (const TorrentID &id : asConst(removedTorrents))
+        m_storedMetadata.remove(id);
+
+    qDebug() << "Flushed resume data to database. Rows:" << changes.size()
+             << "Commit latency (ms):" << commitTimer.elapsed();
+}
+
+void BitTorrent::DBResumeDataStorage::Worker::handleFlushFailure(const QString &errorMessage
+        , const QHash<TorrentID, std::optional<LoadTorrentParams>> &changes)
+{
+    if (!m_isFlushFailed)
+    {
+        m_isFlushFailed = true;
+        LogMsg(tr("Couldn't store resume data. Error: %1").arg(errorMessage), Log::CRITICAL);
+    }
+
+    // Retry less often while the database remains unavailable
+    m_flushTimer->setInterval(std::min((m_flushTimer->interval() * 2), MAX_FLUSH_RETRY_INTERVAL));
+
+    // Changes that were queued after the failed flush are newer so they take precedence
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it)
+    {
+        if (!m_pendingChanges.contains(it.key()))
+            m_pendingChanges.insert(it.key(), it.value());
+    }
+
+    scheduleFlush();
+}
+
+QSqlQuery &BitTorrent::DBResumeDataStorage::Worker::preparedQuery(std::optional<QSqlQuery> &query, const QString &statement) const
+{
+    if (!query)
+    {
+        query.emplace(QSqlDatabase::database(m_connectionName));
+        if (!query->prepare(statement))
+        {
+            const QString errorMessage = query->lastError().text();
+            query.reset();
+            throw RuntimeError(errorMessage);
+        }
+    }
+
+    return *query;
+}
+
+bool BitTorrent::DBResumeDataStorage::Worker::storeTorrent(const TorrentID &id, const LoadTorrentParams &resumeData)
 {
     // We need to adjust native libtorrent resume data
     lt::add_torrent_params p = resumeData.ltAddTorrentParams;
@@ -454,11 +692,15 @@ void BitTorrent::DBResumeDataStorage::Worker::store(const TorrentID &id, const L
     };
 
     // metadata is stored in separate column
+    // and doesn't need to be written again if it is already stored
     QByteArray bencodedMetadata;
-    bencodedMetadata.reserve(512 * 1024);
-    const std::shared_ptr<lt::torrent_info> torrentInfo = std::move(p.ti);
+    std::shared_ptr<lt::torrent_info> torrentInfo = std::move(p.ti);
+    if (torrentInfo && m_storedMetadata.contains(id))
+        torrentInfo.reset();
+
     if (torrentInfo)
     {
+        bencodedMetadata.reserve(512 * 1024);
         try
         {
             const auto torrentCreator = lt::create_torrent(*torrentInfo);
@@ -469,7 +711,7 @@ void BitTorrent::DBResumeDataStorage::Worker::store(const TorrentID &id, const L
         {
             LogMsg(tr("Couldn't save torrent metadata. Error: %1.")
                    .arg(QString::fromLocal8Bit(err.what())), Log::CRITICAL);
-            return;
+            return false;
         }
 
         columns.append(DB_COLUMN_METADATA);
@@ -479,15 +721,12 @@ void BitTorrent::DBResumeDataStorage::Worker::store(const TorrentID &id, const L
     bencodedResumeData.reserve(256 * 1024);
     lt::bencode(std::back_inserter(bencodedResumeData), lt::write_resume_data(p));
 
-    const QString insertTorrentStatement = makeInsertStatement(DB_TABLE_TORRENTS, columns)
-            + makeOnConflictUpdateStatement(DB_COLUMN_TORRENT_ID, columns);
-    auto db = QSqlDatabase::database(m_connectionName);
-    QSqlQuery query {db};
-
     try
     {
-        if (!query.prepare(insertTorrentStatement))
-            throw RuntimeError(query.lastError().text());
+        const QString insertTorrentStatement = makeInsertStatement(DB_TABLE_TORRENTS, columns)
+                + makeOnConflictUpdateStatement(DB_COLUMN_TORRENT_ID, columns);
+        QSqlQuery &query = preparedQuery((torrentInfo ? m_insertTorrentWithMetadataQuery : m_insertTorrentQuery)
+                                         , insertTorrentStatement);
 
         query.bindValue(DB_COLUMN_TORRENT_ID.placeholder, id.toString());
         query.bindValue(DB_COLUMN_NAME.placeholder, resumeData.name);
@@ -513,21 +752,20 @@ void BitTorrent::DBResumeDataStorage::Worker::store(const TorrentID &id, const L
     {
         LogMsg(tr("Couldn't store resume data for torrent '%1'. Error: %2")
             .arg(id.toString(), err.message()), Log::CRITICAL);
+        return false;
     }
+
+    return true;
 }
 
-void BitTorrent::DBResumeDataStorage::Worker::remove(const TorrentID &id) const
+bool BitTorrent::DBResumeDataStorage::Worker::removeTorrent(const TorrentID &id)
 {
     const auto deleteTorrentStatement = QString::fromLatin1("DELETE FROM %1 WHERE %2 = %3;")
             .arg(quoted(DB_TABLE_TORRENTS), quoted(DB_COLUMN_TORRENT_ID.name), DB_COLUMN_TORRENT_ID.placeholder);
 
-    auto db = QSqlDatabase::database(m_connectionName);
-    QSqlQuery query {db};
-
     try
     {
-        if (!query.prepare(deleteTorrentStatement))
-            throw RuntimeError(query.lastError().text());
+        QSqlQuery &query = preparedQuery(m_deleteTorrentQuery, deleteTorrentStatement);
 
         query.bindValue(DB_COLUMN_TORRENT_ID.placeholder, id.toString());
         if (!query.exec())
@@ -537,11 +775,17 @@ void BitTorrent::DBResumeDataStorage::Worker::remove(const TorrentID &id) const
     {
         LogMsg(tr("Couldn't delete resume data of torrent '%1'. Error: %2")
             .arg(id.toString(), err.message()), Log::CRITICAL);
+        return false;
     }
+
+    return true;
 }
 
-void BitTorrent::DBResumeDataStorage::Worker::storeQueue(const QVector<TorrentID> &queue) const
+void BitTorrent::DBResumeDataStorage::Worker::storeQueue(const QVector<TorrentID> &queue)
 {
+    // queue positions can refer to the torrents which are not stored yet
+    flush();
+
     const auto updateQueuePosStatement = QString::fromLatin1("UPDATE %1 SET %2 = %3 WHERE %4 = %5;")
             .arg(quoted(DB_TABLE_TORRENTS), quoted(DB_COLUMN_QUEUE_POSITION.name), DB_COLUMN_QUEUE_POSITION.placeholder
                  , quoted(DB_COLUMN_TORRENT_ID.name), DB_COLUMN_TORRENT_ID.placeholder);
@@ -30,6 +30,7 @@
 
 #include "resumedatastorage.h"
 
+class QSqlDatabase;
 class QThread;
 
 namespace BitTorrent
@@ -50,6 +51,8 @@ namespace BitTorrent
         void storeQueue(const QVector<TorrentID> &queue) const override;
 
     private:
+        void readAll(const ReadResumeDataHandler &handler) const override;
+        void readTorrents(const QSqlDatabase &db, const ReadResumeDataHandler &handler) const;
         void createDB() const;
 
         QThread *m_ioThread = nullptr;
@@ -28,408 +28,545 @@
 
 #include "filterparserthread.h"
 
+#include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <libtorrent/error_code.hpp>
 
+#include <QByteArray>
+#include <QCryptographicHash>
 #include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThreadPool>
 
 #include "base/logger.h"
+#include "base/profile.h"
+#include "base/utils/fs.h"
 
 namespace
 {
-    class IPv4Parser
+    const int MAX_LOGGED_ERRORS = 5;
+    // Text filter files smaller than this are parsed by a single thread
+    const qint64 MIN_CHUNK_SIZE = 1024 * 1024; // 1 MiB
+
+    enum class LineStatus
     {
-    public:
-        bool tryParse(const char *str)
-        {
-            unsigned char octetIndex = 0;
+        Ok,
+        Ignored,
+        Malformed,
+        MalformedStartIP,
+        MalformedEndIP,
+        IPVersionMismatch
+    };
 
-            const char *octetStart = str;
-            char *endptr;
-            for (; *str; ++str)
-            {
-                if (*str == '.')
-                {
-                    const long int extractedNum = strtol(octetStart, &endptr, 10);
-                    if ((extractedNum >= 0L) && (extractedNum <= 255L))
-                        m_buf[octetIndex++] = static_cast<unsigned char>(extractedNum);
-                    else
-                        return false;
-
-                    if (endptr != str)
-                        return false;
-                    if (octetIndex == 4)
-                        return true;
-
-                    octetStart = str + 1;
-                }
-            }
+    struct IPRange
+    {
+        lt::address first;
+        lt::address last;
+        int line = 0;
+    };
 
-            if (str != octetStart)
-            {
-                const long int extractedNum = strtol(octetStart, &endptr, 10);
-                if ((extractedNum >= 0L) && (extractedNum <= 255L))
-                    m_buf[octetIndex] = static_cast<unsigned char>(strtol(octetStart, &endptr, 10));
-                else
-                    return false;
+    struct ChunkResult
+    {
+        std::vector<IPRange> ranges;
+        // first errors of the chunk as (line, status) pairs
+        std::vector<std::pair<int, LineStatus>> errors;
+        int errorCount = 0;
+        int lineCount = 0;
+    };
 
-                if ((endptr == str) && (octetIndex == 3))
-                    return true;
-            }
+    using LineParser = LineStatus (*)(const char *begin, const char *end, IPRange &range);
 
-            return false;
+    class ParseTask final : public QRunnable
+    {
+    public:
+        explicit ParseTask(std::function<void ()> func)
+            : m_func {std::move(func)}
+        {
         }
 
-        lt::address_v4::bytes_type parsed() const
+        void run() override
         {
-            return m_buf;
+            m_func();
         }
 
     private:
-        lt::address_v4::bytes_type m_buf;
+        const std::function<void ()> m_func;
     };
 
-    bool parseIPAddress(const char *data, lt::address &address)
+    bool isSpace(const char c)
     {
-        IPv4Parser parser;
-        lt::error_code ec;
+        return (std::isspace(static_cast<unsigned char>(c)) != 0);
+    }
+
+    bool isDigit(const char c)
+    {
+        return ((c >= '0') && (c <= '9'));
+    }
+
+    // memchr() is usually vectorized by the C library
+    const char *findChar(const char *begin, const char *end, const char c)
+    {
+        const void *found = std::memchr(begin, c, (end - begin));
+        return (found ? static_cast<const char *>(found) : end);
+    }
+
+    const char *findLastChar(const char *begin, const char *end, const char c)
+    {
+        for (const char *ptr = end; ptr != begin;)
+        {
+            --ptr;
+            if (*ptr == c)
+                return ptr;
+        }
+
+        return end;
+    }
 
-        if (parser.tryParse(data))
-            address = lt::address_v4(parser.parsed());
-        else
-            address = lt::make_address(data, ec);
+    void trim(const char *&begin, const char *&end)
+    {
+        while ((begin != end) && isSpace(*begin))
+            ++begin;
+        while ((begin != end) && isSpace(*(end - 1)))
+            --end;
+    }
 
+    bool parseIPv4Address(const char *begin, const char *end, lt::address_v4::bytes_type &out)
+    {
+        int octetIndex = 0;
+        int octet = -1;
+        for (const char *ptr = begin; ptr != end; ++ptr)
+        {
+            if (isDigit(*ptr))
+            {
+                octet = ((octet < 0) ? 0 : (octet * 10)) + (*ptr - '0');
+                if (octet > 255)
+                    return false;
+            }
+            else if ((*ptr == '.') && (octet >= 0) && (octetIndex < 3))
+            {
+                out[octetIndex++] = static_cast<unsigned char>(octet);
+                octet = -1;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if ((octet < 0) || (octetIndex != 3))
+            return false;
+
+        out[octetIndex] = static_cast<unsigned char>(octet);
+        return true;
+    }
+
+    bool parseIPAddress(const char *begin, const char *end, lt::address &address)
+    {
+        lt::address_v4::bytes_type ipv4Bytes;
+        if (parseIPv4Address(begin, end, ipv4Bytes))
+        {
+            address = lt::address_v4(ipv4Bytes);
+            return true;
+        }
+
+        lt::error_code ec;
+        address = lt::make_address(std::string(begin, end), ec);
         return !ec;
     }
 
-    const int BUFFER_SIZE = 2 * 1024 * 1024; // 2 MiB
-    const int MAX_LOGGED_ERRORS = 5;
-}
+    bool isComment(const char *begin, const char *end)
+    {
+        if (begin == end)
+            return false;
 
-FilterParserThread::FilterParserThread(QObject *parent)
-    : QThread(parent)
-    , m_abort(false)
-{
-}
+        return ((*begin == '#')
+                || ((*begin == '/') && ((end - begin) > 1) && (*(begin + 1) == '/')));
+    }
 
-FilterParserThread::~FilterParserThread()
-{
-    m_abort = true;
-    wait();
-}
+    // Behaves like strtol() but doesn't need a null terminated string
+    long parseAccessLevel(const char *begin, const char *end)
+    {
+        while ((begin != end) && isSpace(*begin))
+            ++begin;
 
-// Parser for eMule ip filter in DAT format
-int FilterParserThread::parseDATFilterFile()
-{
-    int ruleCount = 0;
-    QFile file(m_filePath);
-    if (!file.exists()) return ruleCount;
+        bool negative = false;
+        if ((begin != end) && ((*begin == '-') || (*begin == '+')))
+        {
+            negative = (*begin == '-');
+            ++begin;
+        }
+
+        long value = 0;
+        for (; (begin != end) && isDigit(*begin); ++begin)
+            value = std::min((value * 10) + (*begin - '0'), 1000L);
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return (negative ? -value : value);
+    }
+
+    LineStatus parseIPRange(const char *begin, const char *delimiter, const char *end, IPRange &range)
     {
-        LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
-        return ruleCount;
+        const char *startBegin = begin;
+        const char *startEnd = delimiter;
+        trim(startBegin, startEnd);
+        if (!parseIPAddress(startBegin, startEnd, range.first))
+            return LineStatus::MalformedStartIP;
+
+        const char *endBegin = delimiter + 1;
+        const char *endEnd = end;
+        trim(endBegin, endEnd);
+        if (!parseIPAddress(endBegin, endEnd, range.last))
+            return LineStatus::MalformedEndIP;
+
+        if ((range.first.is_v4() != range.last.is_v4())
+            || (range.first.is_v6() != range.last.is_v6()))
+        {
+            return LineStatus::IPVersionMismatch;
+        }
+
+        return LineStatus::Ok;
     }
 
-    std::vector<char> buffer(BUFFER_SIZE, 0); // seems a bit faster than QVector
-    qint64 bytesRead = 0;
-    int offset = 0;
-    int start = 0;
-    int endOfLine = -1;
-    int nbLine = 0;
-    int parseErrorCount = 0;
-    const auto addLog = [&parseErrorCount](const QString &msg)
+    // Parser for eMule ip filter in DAT format
+    LineStatus parseDATLine(const char *begin, const char *end, IPRange &range)
     {
-        if (parseErrorCount <= MAX_LOGGED_ERRORS)
-            LogMsg(msg, Log::CRITICAL);
-    };
+        if (isComment(begin, end))
+            return LineStatus::Ignored;
+
+        // Each line should follow this format:
+        // 001.009.096.105 - 001.009.096.105 , 000 , Some organization
+        // The 3rd entry is access level and if above 127 the IP range isn't blocked.
+        const char *firstComma = findChar(begin, end, ',');
+        if (firstComma != end)
+        {
+            // Check if there is an access value (apparently not mandatory)
+            const char *secondComma = findChar((firstComma + 1), end, ',');
+            // Ignoring this rule because access value is too high
+            if (parseAccessLevel((firstComma + 1), secondComma) > 127L)
+                return LineStatus::Ignored;
+        }
+
+        // IP Range should be split by a dash
+        const char *delimIP = findChar(begin, firstComma, '-');
+        if (delimIP == firstComma)
+            return LineStatus::Malformed;
 
-    while (true)
+        return parseIPRange(begin, delimIP, firstComma, range);
+    }
+
+    // Parser for PeerGuardian ip filter in p2p format
+    LineStatus parseP2PLine(const char *begin, const char *end, IPRange &range)
     {
-        bytesRead = file.read(buffer.data() + offset, BUFFER_SIZE - offset - 1);
-        if (bytesRead < 0)
-            break;
-        const int dataSize = bytesRead + offset;
-        if ((bytesRead == 0) && (dataSize == 0))
-            break;
+        if (isComment(begin, end))
+            return LineStatus::Ignored;
+
+        // Each line should follow this format:
+        // Some organization:1.0.0.0-1.255.255.255
+        // The "Some organization" part might contain a ':' char itself so we find the last occurrence
+        const char *partsDelimiter = findLastChar(begin, end, ':');
+        if (partsDelimiter == end)
+            return LineStatus::Malformed;
+
+        // IP Range should be split by a dash
+        const char *delimIP = findChar((partsDelimiter + 1), end, '-');
+        if (delimIP == end)
+            return LineStatus::Malformed;
+
+        return parseIPRange((partsDelimiter + 1), delimIP, end, range);
+    }
 
-        for (start = 0; start < dataSize; ++start)
+    ChunkResult parseChunk(const char *begin, const char *end, const LineParser parseLine, const std::atomic_bool &abort)
+    {
+        ChunkResult result;
+
+        const char *lineBegin = begin;
+        while ((lineBegin < end) && !abort)
         {
-            endOfLine = -1;
-            // The file might have ended without the last line having a newline
-            if (!((bytesRead == 0) && (dataSize > 0)))
+            const char *lineEnd = findChar(lineBegin, end, '\n');
+            ++result.lineCount;
+
+            IPRange range;
+            const LineStatus status = parseLine(lineBegin, lineEnd, range);
+            if (status == LineStatus::Ok)
             {
-                for (int i = start; i < dataSize; ++i)
-                {
-                    if (buffer[i] == '\n')
-                    {
-                        endOfLine = i;
-                        // We need to NULL the newline in case the line has only an IP range.
-                        // In that case the parser won't work for the end IP, because it ends
-                        // with the newline and not with a number.
-                        buffer[i] = '\0';
-                        break;
-                    }
-                }
+                range.line = result.lineCount;
+                result.ranges.push_back(range);
             }
-            else
+            else if (status != LineStatus::Ignored)
             {
-                endOfLine = dataSize;
-                buffer[dataSize] = '\0';
+                ++result.errorCount;
+                if (static_cast<int>(result.errors.size()) < MAX_LOGGED_ERRORS)
+                    result.errors.emplace_back(result.lineCount, status);
             }
 
-            if (endOfLine == -1)
-            {
-                // read the next chunk from file
-                // but first move(copy) the leftover data to the front of the buffer
-                offset = dataSize - start;
-                memmove(buffer.data(), buffer.data() + start, offset);
-                break;
-            }
+            lineBegin = lineEnd + 1;
+        }
 
-            ++nbLine;
+        return result;
+    }
 
-            if ((buffer[start] == '#')
-                || ((buffer[start] == '/') && ((start + 1 < dataSize) && (buffer[start + 1] == '/'))))
-                {
-                start = endOfLine;
-                continue;
-            }
+    // Compiled filter cache
+    // Stores the merged blocked ranges of the last parsed filter file so that
+    // it doesn't need to be parsed again while it stays unchanged.
+    const char IPFILTER_CACHE_FILENAME[] = "ipfilter.cache";
+    const quint32 IPFILTER_CACHE_MAGIC = 0x71624950; // "qbIP"
+    const quint32 IPFILTER_CACHE_VERSION = 1;
 
-            // Each line should follow this format:
-            // 001.009.096.105 - 001.009.096.105 , 000 , Some organization
-            // The 3rd entry is access level and if above 127 the IP range isn't blocked.
-            const int firstComma = findAndNullDelimiter(buffer.data(), ',', start, endOfLine);
-            if (firstComma != -1)
-                findAndNullDelimiter(buffer.data(), ',', firstComma + 1, endOfLine);
+    struct FilterCacheKey
+    {
+        QString filePath;
+        qint64 fileSize = 0;
+        qint64 lastModified = 0;
+        QByteArray fileHash;
+    };
 
-            // Check if there is an access value (apparently not mandatory)
-            if (firstComma != -1)
-            {
-                // There is possibly one
-                const long int nbAccess = strtol(buffer.data() + firstComma + 1, nullptr, 10);
-                // Ignoring this rule because access value is too high
-                if (nbAccess > 127L)
-                {
-                    start = endOfLine;
-                    continue;
-                }
-            }
+    QString filterCachePath()
+    {
+        return Utils::Fs::expandPathAbs(specialFolderLocation(SpecialFolder::Data) + IPFILTER_CACHE_FILENAME);
+    }
 
-            // IP Range should be split by a dash
-            const int endOfIPRange = ((firstComma == -1) ? (endOfLine - 1) : (firstComma - 1));
-            const int delimIP = findAndNullDelimiter(buffer.data(), '-', start, endOfIPRange);
-            if (delimIP == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    std::optional<FilterCacheKey> makeFilterCacheKey(const QString &filePath)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+            return std::nullopt;
 
-            lt::address startAddr;
-            int newStart = trim(buffer.data(), start, delimIP - 1);
-            if (!parseIPAddress(buffer.data() + newStart, startAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        if (!hash.addData(&file))
+            return std::nullopt;
 
-            lt::address endAddr;
-            newStart = trim(buffer.data(), delimIP + 1, endOfIPRange);
-            if (!parseIPAddress(buffer.data() + newStart, endAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+        const QFileInfo fileInfo(filePath);
+        return FilterCacheKey {fileInfo.absoluteFilePath(), fileInfo.size()
+                , fileInfo.lastModified().toMSecsSinceEpoch(), hash.result()};
+    }
 
-            if ((startAddr.is_v4() != endAddr.is_v4())
-                || (startAddr.is_v6() != endAddr.is_v6()))
-                {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    std::optional<int> loadFilterCache(const FilterCacheKey &key, lt::ip_filter &filter)
+    {
+        QFile file(filterCachePath());
+        if (!file.open(QIODevice::ReadOnly))
+            return std::nullopt;
+
+        QDataStream stream(&file);
+        quint32 magic = 0;
+        quint32 version = 0;
+        stream >> magic >> version;
+        if ((magic != IPFILTER_CACHE_MAGIC) || (version != IPFILTER_CACHE_VERSION))
+            return std::nullopt;
+
+        FilterCacheKey cachedKey;
+        quint32 ruleCount = 0;
+        quint32 v4RangeCount = 0;
+        quint32 v6RangeCount = 0;
+        stream >> cachedKey.filePath >> cachedKey.fileSize >> cachedKey.lastModified >> cachedKey.fileHash
+               >> ruleCount >> v4RangeCount >> v6RangeCount;
+        if ((stream.status() != QDataStream::Ok)
+            || (cachedKey.filePath != key.filePath) || (cachedKey.fileSize != key.fileSize)
+            || (cachedKey.lastModified != key.lastModified) || (cachedKey.fileHash != key.fileHash))
+        {
+            return std::nullopt;
+        }
 
-            start = endOfLine;
+        // Ranges are stored as raw [first, last] pairs.
+        // Damaged cache must not make us allocate more than the rest of the file.
+        const qint64 v4RangesSize = static_cast<qint64>(v4RangeCount) * 2 * sizeof(quint32);
+        const qint64 v6RangesSize = static_cast<qint64>(v6RangeCount) * 2 * sizeof(lt::address_v6::bytes_type);
+        if (((v4RangesSize + v6RangesSize) != (file.size() - file.pos()))
+            || (v4RangesSize > std::numeric_limits<int>::max()) || (v6RangesSize > std::numeric_limits<int>::max()))
+        {
+            return std::nullopt;
+        }
 
-            // Now Add to the filter
-            try
+        std::vector<quint32> v4Ranges(static_cast<std::size_t>(v4RangeCount) * 2);
+        std::vector<lt::address_v6::bytes_type> v6Ranges(static_cast<std::size_t>(v6RangeCount) * 2);
+        const int v4DataSize = static_cast<int>(v4RangesSize);
+        const int v6DataSize = static_cast<int>(v6RangesSize);
+        if ((stream.readRawData(reinterpret_cast<char *>(v4Ranges.data()), v4DataSize) != v4DataSize)
+            || (stream.readRawData(reinterpret_cast<char *>(v6Ranges.data()), v6DataSize) != v6DataSize))
+        {
+            return std::nullopt;
+        }
+
+        lt::ip_filter cachedFilter;
+        for (std::size_t i = 0; i < v4Ranges.size(); i += 2)
+            cachedFilter.add_rule(lt::address_v4(v4Ranges[i]), lt::address_v4(v4Ranges[i + 1]), lt::ip_filter::blocked);
+        for (std::size_t i = 0; i < v6Ranges.size(); i += 2)
+            cachedFilter.add_rule(lt::address_v6(v6Ranges[i]), lt::address_v6(v6Ranges[i + 1]), lt::ip_filter::blocked);
+
+        filter = cachedFilter;
+        return static_cast<int>(ruleCount);
+    }
+
+    void storeFilterCache(const FilterCacheKey &key, const lt::ip_filter &filter, const int ruleCount)
+    {
+        const auto [v4Filter, v6Filter] = filter.export_filter();
+
+        std::vector<quint32> v4Ranges;
+        v4Ranges.reserve(v4Filter.size() * 2);
+        for (const lt::ip_range<lt::address_v4> &range : v4Filter)
+        {
+            if (range.flags & lt::ip_filter::blocked)
             {
-                m_filter.add_rule(startAddr, endAddr, lt::ip_filter::blocked);
-                ++ruleCount;
+                v4Ranges.push_back(range.first.to_uint());
+                v4Ranges.push_back(range.last.to_uint());
             }
-            catch (const std::exception &e)
+        }
+
+        std::vector<lt::address_v6::bytes_type> v6Ranges;
+        v6Ranges.reserve(v6Filter.size() * 2);
+        for (const lt::ip_range<lt::address_v6> &range : v6Filter)
+        {
+            if (range.flags & lt::ip_filter::blocked)
             {
-                ++parseErrorCount;
-                addLog(tr("IP filter exception thrown for line %1. Exception is: %2")
-                       .arg(nbLine).arg(QString::fromLocal8Bit(e.what())));
+                v6Ranges.push_back(range.first.to_bytes());
+                v6Ranges.push_back(range.last.to_bytes());
             }
         }
 
-        if (start >= dataSize)
-            offset = 0;
+        QSaveFile file(filterCachePath());
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            qDebug() << "Couldn't store IP filter cache:" << file.errorString();
+            return;
+        }
+
+        QDataStream stream(&file);
+        stream << IPFILTER_CACHE_MAGIC << IPFILTER_CACHE_VERSION
+               << key.filePath << key.fileSize << key.lastModified << key.fileHash
+               << static_cast<quint32>(ruleCount)
+               << static_cast<quint32>(v4Ranges.size() / 2) << static_cast<quint32>(v6Ranges.size() / 2);
+        stream.writeRawData(reinterpret_cast<const char *>(v4Ranges.data())
+                            , static_cast<int>(v4Ranges.size() * sizeof(quint32)));
+        stream.writeRawData(reinterpret_cast<const char *>(v6Ranges.data())
+                            , static_cast<int>(v6Ranges.size() * sizeof(lt::address_v6::bytes_type)));
+
+        if ((stream.status() != QDataStream::Ok) || !file.commit())
+            qDebug() << "Couldn't store IP filter cache:" << file.errorString();
     }
+}
 
-    if (parseErrorCount > MAX_LOGGED_ERRORS)
-        LogMsg(tr("%1 extra IP filter parsing errors occurred.", "513 extra IP filter parsing errors occurred.")
-               .arg(parseErrorCount - MAX_LOGGED_ERRORS), Log::CRITICAL);
-    return ruleCount;
+FilterParserThread::FilterParserThread(QObject *parent)
+    : QThread(parent)
+    , m_abort(false)
+{
 }
 
-// Parser for PeerGuardian ip filter in p2p format
-int FilterParserThread::parseP2PFilterFile()
+FilterParserThread::~FilterParserThread()
+{
+    m_abort = true;
+    wait();
+}
+
+// Parser for text ip filters (DAT and P2P formats)
+// The file is split on line boundaries into chunks that are parsed in parallel
+int FilterParserThread::parseTextFilterFile(const TextFilterFormat format)
 {
     int ruleCount = 0;
     QFile file(m_filePath);
     if (!file.exists()) return ruleCount;
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if (!file.open(QIODevice::ReadOnly))
     {
         LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
         return ruleCount;
     }
 
-    std::vector<char> buffer(BUFFER_SIZE, 0); // seems a bit faster than QVector
-    qint64 bytesRead = 0;
-    int offset = 0;
-    int start = 0;
-    int endOfLine = -1;
-    int nbLine = 0;
+    qint64 dataSize = file.size();
+    if (dataSize <= 0) return ruleCount;
+
+    QByteArray buffer;
+    const char *data = reinterpret_cast<const char *>(file.map(0, dataSize));
+    if (!data)
+    {
+        buffer = file.readAll();
+        data = buffer.constData();
+        dataSize = buffer.size();
+    }
+    const char *dataEnd = data + dataSize;
+
+    const int chunkCount = static_cast<int>(std::clamp<qint64>((dataSize / MIN_CHUNK_SIZE), 1, QThread::idealThreadCount()));
+    std::vector<const char *> chunkBounds {data};
+    for (int i = 1; i < chunkCount; ++i)
+    {
+        const char *bound = std::max(chunkBounds.back(), (data + (dataSize * i / chunkCount)));
+        bound = findChar(bound, dataEnd, '\n');
+        chunkBounds.push_back((bound == dataEnd) ? dataEnd : (bound + 1));
+    }
+    chunkBounds.push_back(dataEnd);
+
+    const LineParser parseLine = (format == TextFilterFormat::DAT) ? parseDATLine : parseP2PLine;
+    std::vector<ChunkResult> results(chunkCount);
+    QThreadPool pool;
+    for (int i = 0; i < chunkCount; ++i)
+    {
+        pool.start(new ParseTask([this, &results, &chunkBounds, parseLine, i]()
+        {
+            results[i] = parseChunk(chunkBounds[i], chunkBounds[i + 1], parseLine, m_abort);
+        }));
+    }
+    pool.waitForDone();
+
+    if (m_abort) return ruleCount;
+
     int parseErrorCount = 0;
     const auto addLog = [&parseErrorCount](const QString &msg)
     {
         if (parseErrorCount <= MAX_LOGGED_ERRORS)
             LogMsg(msg, Log::CRITICAL);
     };
-
-    while (true)
+    const auto errorMessage = [](const LineStatus status, const int line) -> QString
     {
-        bytesRead = file.read(buffer.data() + offset, BUFFER_SIZE - offset - 1);
-        if (bytesRead < 0)
-            break;
-        const int dataSize = bytesRead + offset;
-        if ((bytesRead == 0) && (dataSize == 0))
-            break;
-
-        for (start = 0; start < dataSize; ++start)
+        switch (status)
         {
-            endOfLine = -1;
-            // The file might have ended without the last line having a newline
-            if (!((bytesRead == 0) && (dataSize > 0)))
-            {
-                for (int i = start; i < dataSize; ++i)
-                {
-                    if (buffer[i] == '\n')
-                    {
-                        endOfLine = i;
-                        // We need to NULL the newline in case the line has only an IP range.
-                        // In that case the parser won't work for the end IP, because it ends
-                        // with the newline and not with a number.
-                        buffer[i] = '\0';
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                endOfLine = dataSize;
-                buffer[dataSize] = '\0';
-            }
-
-            if (endOfLine == -1)
-            {
-                // read the next chunk from file
-                // but first move(copy) the leftover data to the front of the buffer
-                offset = dataSize - start;
-                memmove(buffer.data(), buffer.data() + start, offset);
-                break;
-            }
-
-            ++nbLine;
-
-            if ((buffer[start] == '#')
-                || ((buffer[start] == '/') && ((start + 1 < dataSize) && (buffer[start + 1] == '/'))))
-                {
-                start = endOfLine;
-                continue;
-            }
-
-            // Each line should follow this format:
-            // Some organization:1.0.0.0-1.255.255.255
-            // The "Some organization" part might contain a ':' char itself so we find the last occurrence
-            const int partsDelimiter = findAndNullDelimiter(buffer.data(), ':', start, endOfLine, true);
-            if (partsDelimiter == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            // IP Range should be split by a dash
-            const int delimIP = findAndNullDelimiter(buffer.data(), '-', partsDelimiter + 1, endOfLine);
-            if (delimIP == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            lt::address startAddr;
-            int newStart = trim(buffer.data(), partsDelimiter + 1, delimIP - 1);
-            if (!parseIPAddress(buffer.data() + newStart, startAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            lt::address endAddr;
-            newStart = trim(buffer.data(), delimIP + 1, endOfLine);
-            if (!parseIPAddress(buffer.data() + newStart, endAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            if ((startAddr.is_v4() != endAddr.is_v4())
-                || (startAddr.is_v6() != endAddr.is_v6()))
-                {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+        case LineStatus::MalformedStartIP:
+            return tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(line);
+        case LineStatus::MalformedEndIP:
+            return tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(line);
+        case LineStatus::IPVersionMismatch:
+            return tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(line);
+        default:
+            return tr("IP filter line %1 is malformed.").arg(line);
+        }
+    };
 
-            start = endOfLine;
+    // Merge the chunks in file order so line numbers and logged errors stay the same
+    int lineOffset = 0;
+    for (const ChunkResult &result : results)
+    {
+        for (const auto &[line, status] : result.errors)
+        {
+            ++parseErrorCount;
+            addLog(errorMessage(status, (lineOffset + line)));
+        }
+        parseErrorCount += result.errorCount - static_cast<int>(result.errors.size());
 
+        for (const IPRange &range : result.ranges)
+        {
             try
             {
-                m_filter.add_rule(startAddr, endAddr, lt::ip_filter::blocked);
+                m_filter.add_rule(range.first, range.last, lt::ip_filter::blocked);
                 ++ruleCount;
             }
             catch (const std::exception &e)
             {
                 ++parseErrorCount;
                 addLog(tr("IP filter exception thrown for line %1. Exception is: %2")
-                       .arg(nbLine).arg(QString::fromLocal8Bit(e.what())));
+                       .arg(lineOffset + range.line).arg(QString::fromLocal8Bit(e.what())));
             }
         }
 
-        if (start >= dataSize)
-            offset = 0;
+        lineOffset += result.lineCount;
     }
 
     if (parseErrorCount > MAX_LOGGED_ERRORS)
@@ -617,10 +754,18 @@ void FilterParserThread::run()
 {
     qDebug("Processing filter file");
     int ruleCount = 0;
-    if (m_filePath.endsWith(".p2p", Qt::CaseInsensitive))
+
+    const std::optional<FilterCacheKey> cacheKey = makeFilterCacheKey(m_filePath);
+    const std::optional<int> cachedRuleCount = cacheKey ? loadFilterCache(*cacheKey, m_filter) : std::nullopt;
+    if (cachedRuleCount)
+    {
+        qDebug("IP Filter thread: loaded compiled filter from cache");
+        ruleCount = *cachedRuleCount;
+    }
+    else if (m_filePath.endsWith(".p2p", Qt::CaseInsensitive))
     {
         // PeerGuardian p2p file
-        ruleCount = parseP2PFilterFile();
+        ruleCount = parseTextFilterFile(TextFilterFormat::P2P);
     }
     else if (m_filePath.endsWith(".p2b", Qt::CaseInsensitive))
     {
@@ -630,11 +775,16 @@ void FilterParserThread::run()
     else if (m_filePath.endsWith(".dat", Qt::CaseInsensitive))
     {
         // eMule DAT format
-        ruleCount = parseDATFilterFile();
+        ruleCount = parseTextFilterFile(TextFilterFormat::DAT);
     }
 
     if (m_abort) return;
 
+    // Empty filter isn't cached since it is produced when the file can't be parsed,
+    // so the errors are reported again the next time the file is loaded
+    if (cacheKey && !cachedRuleCount && (ruleCount > 0))
+        storeFilterCache(*cacheKey, m_filter, ruleCount);
+
     try
     {
         emit IPFilterParsed(ruleCount);
@@ -646,60 +796,3 @@ void FilterParserThread::run()
 
     qDebug("IP Filter thread: finished parsing, filter applied");
 }
-
-int FilterParserThread::findAndNullDelimiter(char *const data, const char delimiter, const int start, const int end, const bool reverse)
-{
-    if (!reverse)
-    {
-        for (int i = start; i <= end; ++i)
-        {
-            if (data[i] == delimiter)
-            {
-                data[i] = '\0';
-                return i;
-            }
-        }
-    }
-    else
-    {
-        for (int i = end; i >= start; --i)
-        {
-            if (data[i] == delimiter)
-            {
-                data[i] = '\0';
-                return i;
-            }
-        }
-    }
-
-    return -1;
-}
-
-int FilterParserThread::trim(char *const data, const int start, const int end)
-{
-    if (start >= end) return start;
-    int newStart = start;
-
-    for (int i = start; i <= end; ++i)
-    {
-        if (isspace(data[i]) != 0)
-        {
-            data[i] = '\0';
-        }
-        else
-        {
-            newStart = i;
-            break;
-        }
-    }
-
-    for (int i = end; i >= start; --i)
-    {
-        if (isspace(data[i]) != 0)
-            data[i] = '\0';
-        else
-            break;
-    }
-
-    return newStart;
-}
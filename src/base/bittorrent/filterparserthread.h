@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <libtorrent/ip_filter.hpp>
 
 #include <QThread>
@@ -52,14 +54,17 @@ protected:
     void run() override;
 
 private:
-    int findAndNullDelimiter(char *const data, char delimiter, int start, int end, bool reverse = false);
-    int trim(char *const data, int start, int end);
-    int parseDATFilterFile();
-    int parseP2PFilterFile();
+    enum class TextFilterFormat
+    {
+        DAT,
+        P2P
+    };
+
+    int parseTextFilterFile(TextFilterFormat format);
     int getlineInStream(QDataStream &stream, std::string &name, char delim);
     int parseP2BFilterFile();
 
-    bool m_abort;
+    std::atomic_bool m_abort;
     QString m_filePath;
     lt::ip_filter m_filter;
 };
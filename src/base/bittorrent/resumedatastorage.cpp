@@ -0,0 +1,197 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "resumedatastorage.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+namespace
+{
+    // Limits the number of entries that are read but not fetched yet
+    // so the memory consumption does not depend on the number of torrents
+    const int MAX_PENDING_COUNT = 512;
+
+    class DecodeTask final : public QRunnable
+    {
+    public:
+        explicit DecodeTask(std::function<void ()> func)
+            : m_func {std::move(func)}
+        {
+        }
+
+        void run() override
+        {
+            m_func();
+        }
+
+    private:
+        const std::function<void ()> m_func;
+    };
+}
+
+BitTorrent::ResumeDataStorage::ResumeDataStorage(QObject *parent)
+    : QObject {parent}
+{
+}
+
+BitTorrent::ResumeDataStorage::~ResumeDataStorage()
+{
+    Q_ASSERT(!m_loadingThread);
+}
+
+void BitTorrent::ResumeDataStorage::loadAll()
+{
+    Q_ASSERT(!m_loadingThread);
+
+    m_loadedResumeData.fill(std::nullopt, MAX_PENDING_COUNT);
+    m_readCount = 0;
+    m_fetchedCount = 0;
+    m_decodedCount = 0;
+    m_readFinished = false;
+    m_readNSecs = 0;
+    m_decodeNSecs = 0;
+
+    m_decodingPool = new QThreadPool(this);
+    m_loadingThread = QThread::create([this]()
+    {
+        QElapsedTimer readTimer;
+        readTimer.start();
+
+        readAll([this, &readTimer](const TorrentID &id, const ResumeDataDecoder &decoder)
+        {
+            {
+                const QMutexLocker locker {&m_loadMutex};
+                m_readNSecs += readTimer.nsecsElapsed();
+            }
+
+            enqueueDecoder(id, decoder);
+            readTimer.restart();
+        });
+
+        const QMutexLocker locker {&m_loadMutex};
+        m_readNSecs += readTimer.nsecsElapsed();
+        m_readFinished = true;
+        m_loadedCondition.wakeAll();
+    });
+    m_loadingThread->start();
+}
+
+QVector<BitTorrent::LoadedResumeData> BitTorrent::ResumeDataStorage::fetchLoadedResumeData(const int maxCount)
+{
+    Q_ASSERT(m_loadingThread);
+    if (!m_loadingThread)
+        return {};
+
+    QVector<LoadedResumeData> result;
+    {
+        const QMutexLocker locker {&m_loadMutex};
+        while (!isNextLoaded() && !(m_readFinished && (m_fetchedCount == m_readCount)))
+            m_loadedCondition.wait(&m_loadMutex);
+
+        result.reserve(std::min(maxCount, (m_readCount - m_fetchedCount)));
+        while ((result.size() < maxCount) && isNextLoaded())
+        {
+            std::optional<LoadedResumeData> &slot = m_loadedResumeData[m_fetchedCount % MAX_PENDING_COUNT];
+            result.append(std::move(*slot));
+            slot.reset();
+            ++m_fetchedCount;
+        }
+
+        if (!result.isEmpty())
+            m_fetchedCondition.wakeAll();
+    }
+
+    if (result.isEmpty())
+        waitForLoadingFinished();
+
+    return result;
+}
+
+BitTorrent::ResumeDataLoadStatistics BitTorrent::ResumeDataStorage::loadStatistics() const
+{
+    const QMutexLocker locker {&m_loadMutex};
+
+    ResumeDataLoadStatistics statistics;
+    statistics.readTime = m_readNSecs / 1000000;
+    statistics.decodeTime = m_decodeNSecs / 1000000;
+    statistics.count = m_decodedCount;
+    return statistics;
+}
+
+void BitTorrent::ResumeDataStorage::enqueueDecoder(const TorrentID &id, const ResumeDataDecoder &decoder)
+{
+    int index = 0;
+    {
+        const QMutexLocker locker {&m_loadMutex};
+        while ((m_readCount - m_fetchedCount) >= MAX_PENDING_COUNT)
+            m_fetchedCondition.wait(&m_loadMutex);
+
+        index = m_readCount++;
+    }
+
+    m_decodingPool->start(new DecodeTask([this, id, decoder, index]()
+    {
+        QElapsedTimer decodeTimer;
+        decodeTimer.start();
+        std::optional<LoadTorrentParams> resumeData = decoder();
+        const qint64 decodeNSecs = decodeTimer.nsecsElapsed();
+
+        const QMutexLocker locker {&m_loadMutex};
+        m_loadedResumeData[index % MAX_PENDING_COUNT] = LoadedResumeData {id, std::move(resumeData)};
+        m_decodeNSecs += decodeNSecs;
+        ++m_decodedCount;
+        if (index == m_fetchedCount)
+            m_loadedCondition.wakeAll();
+    }));
+}
+
+bool BitTorrent::ResumeDataStorage::isNextLoaded() const
+{
+    return (m_fetchedCount < m_readCount)
+            && m_loadedResumeData[m_fetchedCount % MAX_PENDING_COUNT].has_value();
+}
+
+void BitTorrent::ResumeDataStorage::waitForLoadingFinished()
+{
+    m_loadingThread->wait();
+    delete m_loadingThread;
+    m_loadingThread = nullptr;
+
+    m_decodingPool->waitForDone();
+    delete m_decodingPool;
+    m_decodingPool = nullptr;
+
+    m_loadedResumeData.clear();
+}
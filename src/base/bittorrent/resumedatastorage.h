@@ -28,15 +28,34 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 
-#include <QtContainerFwd>
+#include <QMutex>
 #include <QObject>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "infohash.h"
+#include "loadtorrentparams.h"
+
+class QThread;
+class QThreadPool;
 
 namespace BitTorrent
 {
-    class TorrentID;
-    struct LoadTorrentParams;
+    struct LoadedResumeData
+    {
+        TorrentID torrentID;
+        std::optional<LoadTorrentParams> resumeData;
+    };
+
+    struct ResumeDataLoadStatistics
+    {
+        qint64 readTime = 0;    // ms spent reading the storage
+        qint64 decodeTime = 0;  // ms spent decoding, summed up over all the decoding threads
+        int count = 0;
+    };
 
     class ResumeDataStorage : public QObject
     {
@@ -44,12 +63,49 @@ namespace BitTorrent
         Q_DISABLE_COPY_MOVE(ResumeDataStorage)
 
     public:
-        using QObject::QObject;
+        explicit ResumeDataStorage(QObject *parent = nullptr);
+        ~ResumeDataStorage() override;
 
         virtual QVector<TorrentID> registeredTorrents() const = 0;
         virtual std::optional<LoadTorrentParams> load(const TorrentID &id) const = 0;
         virtual void store(const TorrentID &id, const LoadTorrentParams &resumeData) const = 0;
         virtual void remove(const TorrentID &id) const = 0;
         virtual void storeQueue(const QVector<TorrentID> &queue) const = 0;
+
+        // Starts loading of all registered torrents in background.
+        // Storage is read in a dedicated thread while the read data is decoded in a thread pool.
+        void loadAll();
+        // Returns the next loaded entries (at most `maxCount`) in the order they were read.
+        // Blocks until at least one entry is available. Returns empty list when all entries are fetched.
+        // All the entries must be fetched before the storage is destroyed.
+        QVector<LoadedResumeData> fetchLoadedResumeData(int maxCount);
+        ResumeDataLoadStatistics loadStatistics() const;
+
+    protected:
+        using ResumeDataDecoder = std::function<std::optional<LoadTorrentParams> ()>;
+        using ReadResumeDataHandler = std::function<void (const TorrentID &id, const ResumeDataDecoder &decoder)>;
+
+        // Should only read raw data from the storage and pass it to `handler` wrapped in decoder
+        // which is invoked later in some other thread. Called from the loading thread.
+        virtual void readAll(const ReadResumeDataHandler &handler) const = 0;
+
+    private:
+        void enqueueDecoder(const TorrentID &id, const ResumeDataDecoder &decoder);
+        bool isNextLoaded() const;
+        void waitForLoadingFinished();
+
+        QThread *m_loadingThread = nullptr;
+        QThreadPool *m_decodingPool = nullptr;
+
+        mutable QMutex m_loadMutex;
+        QWaitCondition m_loadedCondition;
+        QWaitCondition m_fetchedCondition;
+        QVector<std::optional<LoadedResumeData>> m_loadedResumeData;
+        int m_readCount = 0;
+        int m_fetchedCount = 0;
+        int m_decodedCount = 0;
+        bool m_readFinished = false;
+        qint64 m_readNSecs = 0;
+        qint64 m_decodeNSecs = 0;
     };
 }
@@ -55,6 +55,7 @@
 
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QHostAddress>
 #include <QNetworkAddressEntry>
@@ -77,6 +78,7 @@
 #include "base/profile.h"
 #include "base/torrentfileguard.h"
 #include "base/torrentfilter.h"
+#include "base/torrentfilterindex.h"
 #include "base/unicodestrings.h"
 #include "base/utils/bytearray.h"
 #include "base/utils/fs.h"
@@ -107,6 +109,9 @@ namespace
     const char PEER_ID[] = "qB";
     const char USER_AGENT[] = "qBittorrent/" QBT_VERSION_2;
 
+    // Number of torrents added to the session between processing of the alerts at startup
+    const int STARTUP_BATCH_SIZE = 100;
+
     void torrentQueuePositionUp(const lt::torrent_handle &handle)
     {
         try
@@ -462,7 +467,8 @@ Session::Session(QObject *parent)
     connect(m_recentErroredTorrentsTimer, &QTimer::timeout
         , this, [this]() { m_recentErroredTorrents.clear(); });
 
-    m_seedingLimitTimer->setInterval(10000);
+    m_shareLimitsClock.start();
+    m_seedingLimitTimer->setSingleShot(true);
     connect(m_seedingLimitTimer, &QTimer::timeout, this, &Session::processShareLimits);
 
     initializeNativeSession();
@@ -500,6 +506,8 @@ Session::Session(QObject *parent)
     connect(m_networkManager, &QNetworkConfigurationManager::configurationChanged, this, &Session::networkConfigurationChange);
 #endif
 
+    m_torrentFilterIndex = new TorrentFilterIndex(this);
+
     m_fileSearcher = new FileSearcher;
     m_fileSearcher->moveToThread(m_ioThread);
     connect(m_ioThread, &QThread::finished, m_fileSearcher, &QObject::deleteLater);
@@ -940,7 +948,8 @@ void Session::setGlobalMaxRatio(qreal ratio)
     if (ratio != globalMaxRatio())
     {
         m_globalMaxRatio = ratio;
-        updateSeedingLimitTimer();
+        rescheduleShareLimitsChecks();
+        emit globalShareLimitsChanged();
     }
 }
 
@@ -957,7 +966,8 @@ void Session::setGlobalMaxSeedingMinutes(int minutes)
     if (minutes != globalMaxSeedingMinutes())
     {
         m_globalMaxSeedingMinutes = minutes;
-        updateSeedingLimitTimer();
+        rescheduleShareLimitsChecks();
+        emit globalShareLimitsChanged();
     }
 }
 
@@ -1602,87 +1612,117 @@ void Session::processShareLimits()
 {
     qDebug("Processing share limits...");
 
-    // We shouldn't iterate over `m_torrents` in the loop below
-    // since `deleteTorrent()` modifies it indirectly
-    const QHash<TorrentID, TorrentImpl *> torrents {m_torrents};
-    for (TorrentImpl *const torrent : torrents)
+    // Only the torrents that are expected to have reached their limits are checked
+    const qint64 now = m_shareLimitsClock.elapsed();
+    QVector<TorrentID> dueTorrents;
+    for (auto iter = m_shareLimitsQueue.cbegin(); (iter != m_shareLimitsQueue.cend()) && (iter->first <= now);)
     {
-        if (torrent->isSeed() && !torrent->isForced())
+        dueTorrents.append(iter->second);
+        m_shareLimitsQueueEntries.remove(iter->second);
+        iter = m_shareLimitsQueue.erase(iter);
+    }
+
+    // We shouldn't keep pointers to torrents in the loop below
+    // since `deleteTorrent()` can delete them
+    for (const TorrentID &id : asConst(dueTorrents))
+    {
+        TorrentImpl *torrent = m_torrents.value(id);
+        if (!torrent)
+            continue;
+
+        processTorrentShareLimits(torrent);
+
+        torrent = m_torrents.value(id);
+        if (!torrent)
+            continue;
+
+        // The torrents that have already reached their limits aren't checked
+        // again until they are updated, otherwise they would be checked continuously
+        const qint64 dueTime = shareLimitsDueTime(torrent);
+        if (dueTime > now)
+            m_shareLimitsQueueEntries.insert(id, m_shareLimitsQueue.emplace(dueTime, id));
+    }
+
+    updateSeedingLimitTimer();
+}
+
+void Session::processTorrentShareLimits(TorrentImpl *const torrent)
+{
+    if (!torrent->isSeed() || torrent->isForced())
+        return;
+
+    if (torrent->ratioLimit() != Torrent::NO_RATIO_LIMIT)
+    {
+        const qreal ratio = torrent->realRatio();
+        qreal ratioLimit = torrent->ratioLimit();
+        if (ratioLimit == Torrent::USE_GLOBAL_RATIO)
+            // If Global Max Ratio is really set...
+            ratioLimit = globalMaxRatio();
+
+        if (ratioLimit >= 0)
         {
-            if (torrent->ratioLimit() != Torrent::NO_RATIO_LIMIT)
-            {
-                const qreal ratio = torrent->realRatio();
-                qreal ratioLimit = torrent->ratioLimit();
-                if (ratioLimit == Torrent::USE_GLOBAL_RATIO)
-                    // If Global Max Ratio is really set...
-                    ratioLimit = globalMaxRatio();
+            qDebug("Ratio: %f (limit: %f)", ratio, ratioLimit);
 
-                if (ratioLimit >= 0)
+            if ((ratio <= Torrent::MAX_RATIO) && (ratio >= ratioLimit))
+            {
+                if (m_maxRatioAction == Remove)
                 {
-                    qDebug("Ratio: %f (limit: %f)", ratio, ratioLimit);
-
-                    if ((ratio <= Torrent::MAX_RATIO) && (ratio >= ratioLimit))
-                    {
-                        if (m_maxRatioAction == Remove)
-                        {
-                            LogMsg(tr("'%1' reached the maximum ratio you set. Removed.").arg(torrent->name()));
-                            deleteTorrent(torrent->id());
-                        }
-                        else if (m_maxRatioAction == DeleteFiles)
-                        {
-                            LogMsg(tr("'%1' reached the maximum ratio you set. Removed torrent and its files.").arg(torrent->name()));
-                            deleteTorrent(torrent->id(), DeleteTorrentAndFiles);
-                        }
-                        else if ((m_maxRatioAction == Pause) && !torrent->isPaused())
-                        {
-                            torrent->pause();
-                            LogMsg(tr("'%1' reached the maximum ratio you set. Paused.").arg(torrent->name()));
-                        }
-                        else if ((m_maxRatioAction == EnableSuperSeeding) && !torrent->isPaused() && !torrent->superSeeding())
-                        {
-                            torrent->setSuperSeeding(true);
-                            LogMsg(tr("'%1' reached the maximum ratio you set. Enabled super seeding for it.").arg(torrent->name()));
-                        }
-                        continue;
-                    }
+                    LogMsg(tr("'%1' reached the maximum ratio you set. Removed.").arg(torrent->name()));
+                    deleteTorrent(torrent->id());
+                }
+                else if (m_maxRatioAction == DeleteFiles)
+                {
+                    LogMsg(tr("'%1' reached the maximum ratio you set. Removed torrent and its files.").arg(torrent->name()));
+                    deleteTorrent(torrent->id(), DeleteTorrentAndFiles);
+                }
+                else if ((m_maxRatioAction == Pause) && !torrent->isPaused())
+                {
+                    torrent->pause();
+                    LogMsg(tr("'%1' reached the maximum ratio you set. Paused.").arg(torrent->name()));
+                }
+                else if ((m_maxRatioAction == EnableSuperSeeding) && !torrent->isPaused() && !torrent->superSeeding())
+                {
+                    torrent->setSuperSeeding(true);
+                    LogMsg(tr("'%1' reached the maximum ratio you set. Enabled super seeding for it.").arg(torrent->name()));
                 }
+                return;
             }
+        }
+    }
+
+    if (torrent->seedingTimeLimit() != Torrent::NO_SEEDING_TIME_LIMIT)
+    {
+        const qlonglong seedingTimeInMinutes = torrent->seedingTime() / 60;
+        int seedingTimeLimit = torrent->seedingTimeLimit();
+        if (seedingTimeLimit == Torrent::USE_GLOBAL_SEEDING_TIME)
+        {
+             // If Global Seeding Time Limit is really set...
+            seedingTimeLimit = globalMaxSeedingMinutes();
+        }
 
-            if (torrent->seedingTimeLimit() != Torrent::NO_SEEDING_TIME_LIMIT)
+        if (seedingTimeLimit >= 0)
+        {
+            if ((seedingTimeInMinutes <= Torrent::MAX_SEEDING_TIME) && (seedingTimeInMinutes >= seedingTimeLimit))
             {
-                const qlonglong seedingTimeInMinutes = torrent->seedingTime() / 60;
-                int seedingTimeLimit = torrent->seedingTimeLimit();
-                if (seedingTimeLimit == Torrent::USE_GLOBAL_SEEDING_TIME)
+                if (m_maxRatioAction == Remove)
                 {
-                     // If Global Seeding Time Limit is really set...
-                    seedingTimeLimit = globalMaxSeedingMinutes();
+                    LogMsg(tr("'%1' reached the maximum seeding time you set. Removed.").arg(torrent->name()));
+                    deleteTorrent(torrent->id());
                 }
-
-                if (seedingTimeLimit >= 0)
+                else if (m_maxRatioAction == DeleteFiles)
                 {
-                    if ((seedingTimeInMinutes <= Torrent::MAX_SEEDING_TIME) && (seedingTimeInMinutes >= seedingTimeLimit))
-                    {
-                        if (m_maxRatioAction == Remove)
-                        {
-                            LogMsg(tr("'%1' reached the maximum seeding time you set. Removed.").arg(torrent->name()));
-                            deleteTorrent(torrent->id());
-                        }
-                        else if (m_maxRatioAction == DeleteFiles)
-                        {
-                            LogMsg(tr("'%1' reached the maximum seeding time you set. Removed torrent and its files.").arg(torrent->name()));
-                            deleteTorrent(torrent->id(), DeleteTorrentAndFiles);
-                        }
-                        else if ((m_maxRatioAction == Pause) && !torrent->isPaused())
-                        {
-                            torrent->pause();
-                            LogMsg(tr("'%1' reached the maximum seeding time you set. Paused.").arg(torrent->name()));
-                        }
-                        else if ((m_maxRatioAction == EnableSuperSeeding) && !torrent->isPaused() && !torrent->superSeeding())
-                        {
-                            torrent->setSuperSeeding(true);
-                            LogMsg(tr("'%1' reached the maximum seeding time you set. Enabled super seeding for it.").arg(torrent->name()));
-                        }
-                    }
+                    LogMsg(tr("'%1' reached the maximum seeding time you set. Removed torrent and its files.").arg(torrent->name()));
+                    deleteTorrent(torrent->id(), DeleteTorrentAndFiles);
+                }
+                else if ((m_maxRatioAction == Pause) && !torrent->isPaused())
+                {
+                    torrent->pause();
+                    LogMsg(tr("'%1' reached the maximum seeding time you set. Paused.").arg(torrent->name()));
+                }
+                else if ((m_maxRatioAction == EnableSuperSeeding) && !torrent->isPaused() && !torrent->superSeeding())
+                {
+                    torrent->setSuperSeeding(true);
+                    LogMsg(tr("'%1' reached the maximum seeding time you set. Enabled super seeding for it.").arg(torrent->name()));
                 }
             }
         }
@@ -1791,6 +1831,8 @@ bool Session::deleteTorrent(const TorrentID &id, const DeleteOption deleteOption
     qDebug("Deleting torrent with ID: %s", qUtf8Printable(torrent->id().toString()));
     emit torrentAboutToBeRemoved(torrent);
 
+    unscheduleShareLimitsCheck(id);
+
     // Remove it from session
     if (deleteOption == DeleteTorrent)
     {
@@ -2005,6 +2047,11 @@ QVector<Torrent *> Session::torrents() const
     return result;
 }
 
+const TorrentFilterIndex *Session::torrentFilterIndex() const
+{
+    return m_torrentFilterIndex;
+}
+
 bool Session::addTorrent(const QString &source, const AddTorrentParams &params)
 {
     // `source`: .torrent file path/url or magnet uri
@@ -3803,25 +3850,110 @@ bool Session::isKnownTorrent(const TorrentID &id) const
 
 void Session::updateSeedingLimitTimer()
 {
-    if ((globalMaxRatio() == Torrent::NO_RATIO_LIMIT) && !hasPerTorrentRatioLimit()
-        && (globalMaxSeedingMinutes() == Torrent::NO_SEEDING_TIME_LIMIT) && !hasPerTorrentSeedingTimeLimit())
+    if (m_shareLimitsQueue.empty())
+    {
+        m_seedingLimitTimer->stop();
+        return;
+    }
+
+    const qint64 delay = m_shareLimitsQueue.cbegin()->first - m_shareLimitsClock.elapsed();
+    m_seedingLimitTimer->start(static_cast<int>(std::max<qint64>(delay, 0)));
+}
+
+// Returns the time (by `m_shareLimitsClock`) when the torrent is expected to reach its share limits,
+// or -1 if it can't reach them until it is updated. Predictions are recalculated on each update of torrent.
+qint64 Session::shareLimitsDueTime(const TorrentImpl *torrent) const
+{
+    // Predicted time is limited so the prediction error can't grow too much
+    const qint64 MIN_CHECK_DELAY = 1000;
+    const qint64 MAX_CHECK_DELAY = 60 * 60 * 1000;
+
+    if (!torrent->isSeed() || torrent->isForced())
+        return -1;
+
+    const qint64 now = m_shareLimitsClock.elapsed();
+    qint64 dueTime = -1;
+
+    qreal ratioLimit = torrent->ratioLimit();
+    if (ratioLimit == Torrent::USE_GLOBAL_RATIO)
+        ratioLimit = globalMaxRatio();
+
+    if (ratioLimit >= 0)
+    {
+        const qreal ratio = torrent->realRatio();
+        if (ratio >= ratioLimit)
+            return now;
+
+        const int uploadRate = torrent->uploadPayloadRate();
+        if (uploadRate > 0)
         {
-        if (m_seedingLimitTimer->isActive())
-            m_seedingLimitTimer->stop();
+            // ratio grows by `uploadRate / downloaded` per second
+            const qreal downloaded = (ratio > 0) ? (torrent->totalUpload() / ratio) : torrent->totalDownload();
+            const qreal delay = (ratioLimit - ratio) * downloaded * 1000 / uploadRate;
+            dueTime = now + static_cast<qint64>(std::clamp<qreal>(delay, MIN_CHECK_DELAY, MAX_CHECK_DELAY));
+        }
     }
-    else if (!m_seedingLimitTimer->isActive())
+
+    int seedingTimeLimit = torrent->seedingTimeLimit();
+    if (seedingTimeLimit == Torrent::USE_GLOBAL_SEEDING_TIME)
+        seedingTimeLimit = globalMaxSeedingMinutes();
+
+    if (seedingTimeLimit >= 0)
     {
-        m_seedingLimitTimer->start();
+        const qlonglong seedingTime = torrent->seedingTime();
+        if ((seedingTime / 60) >= seedingTimeLimit)
+            return now;
+
+        if (!torrent->isPaused())
+        {
+            const qint64 delay = ((seedingTimeLimit * 60LL) - seedingTime) * 1000;
+            const qint64 seedingTimeDueTime = now + std::clamp(delay, MIN_CHECK_DELAY, MAX_CHECK_DELAY);
+            if ((dueTime < 0) || (seedingTimeDueTime < dueTime))
+                dueTime = seedingTimeDueTime;
+        }
     }
+
+    return dueTime;
 }
 
-void Session::handleTorrentShareLimitChanged(TorrentImpl *const)
+void Session::scheduleShareLimitsCheck(const TorrentImpl *torrent)
 {
+    const TorrentID id = torrent->id();
+    unscheduleShareLimitsCheck(id);
+
+    const qint64 dueTime = shareLimitsDueTime(torrent);
+    if (dueTime >= 0)
+        m_shareLimitsQueueEntries.insert(id, m_shareLimitsQueue.emplace(dueTime, id));
+}
+
+void Session::unscheduleShareLimitsCheck(const TorrentID &id)
+{
+    const auto entryIter = m_shareLimitsQueueEntries.find(id);
+    if (entryIter == m_shareLimitsQueueEntries.end())
+        return;
+
+    m_shareLimitsQueue.erase(entryIter.value());
+    m_shareLimitsQueueEntries.erase(entryIter);
+}
+
+void Session::rescheduleShareLimitsChecks()
+{
+    for (const TorrentImpl *torrent : asConst(m_torrents))
+        scheduleShareLimitsCheck(torrent);
+
+    updateSeedingLimitTimer();
+}
+
+void Session::handleTorrentShareLimitChanged(TorrentImpl *const torrent)
+{
+    scheduleShareLimitsCheck(torrent);
     updateSeedingLimitTimer();
+    emit torrentChanged(torrent);
 }
 
-void Session::handleTorrentNameChanged(TorrentImpl *const)
+void Session::handleTorrentChanged(TorrentImpl *const torrent)
 {
+    emit torrentChanged(torrent);
 }
 
 void Session::handleTorrentSavePathChanged(TorrentImpl *const torrent)
@@ -3970,12 +4102,12 @@ void Session::handleTorrentResumeDataReady(TorrentImpl *const torrent, const Loa
 
 void Session::handleTorrentTrackerReply(TorrentImpl *const torrent, const QString &trackerUrl)
 {
-    emit trackerSuccess(torrent, trackerUrl);
+    m_pendingTrackerEvents[torrent->id()][trackerUrl] = TrackerEvent::Success;
 }
 
 void Session::handleTorrentTrackerError(TorrentImpl *const torrent, const QString &trackerUrl)
 {
-    emit trackerError(torrent, trackerUrl);
+    m_pendingTrackerEvents[torrent->id()][trackerUrl] = TrackerEvent::Error;
 }
 
 bool Session::addMoveTorrentStorageJob(TorrentImpl *torrent, const QString &newPath, const MoveStorageMode mode)
@@ -4079,23 +4211,7 @@ void Session::handleMoveTorrentStorageJobFinished()
 
 void Session::handleTorrentTrackerWarning(TorrentImpl *const torrent, const QString &trackerUrl)
 {
-    emit trackerWarning(torrent, trackerUrl);
-}
-
-bool Session::hasPerTorrentRatioLimit() const
-{
-    return std::any_of(m_torrents.cbegin(), m_torrents.cend(), [](const TorrentImpl *torrent)
-    {
-        return (torrent->ratioLimit() >= 0);
-    });
-}
-
-bool Session::hasPerTorrentSeedingTimeLimit() const
-{
-    return std::any_of(m_torrents.cbegin(), m_torrents.cend(), [](const TorrentImpl *torrent)
-    {
-        return (torrent->seedingTimeLimit() >= 0);
-    });
+    m_pendingTrackerEvents[torrent->id()][trackerUrl] = TrackerEvent::Warning;
 }
 
 void Session::configureDeferred()
@@ -4176,6 +4292,11 @@ const CacheStatus &Session::cacheStatus() const
     return m_cacheStatus;
 }
 
+const AlertStatistics &Session::alertStatistics() const
+{
+    return m_alertStatistics;
+}
+
 void Session::startUpTorrents()
 {
     qDebug("Initializing torrents resume data storage...");
@@ -4211,38 +4332,62 @@ void Session::startUpTorrents()
 
     qDebug("Starting up torrents...");
 
-    const QVector<TorrentID> torrents = startupStorage->registeredTorrents();
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    qint64 addTorrentTime = 0;
+
+    // Resume data is read and decoded in background while
+    // the already loaded torrents are added to the session
+    startupStorage->loadAll();
+
     int resumedTorrentsCount = 0;
     QVector<TorrentID> queue;
-    for (const TorrentID &torrentID : torrents)
+    QVector<LoadedResumeData> loadedResumeData;
+    while (!(loadedResumeData = startupStorage->fetchLoadedResumeData(STARTUP_BATCH_SIZE)).isEmpty())
     {
-        const std::optional<LoadTorrentParams> resumeData = startupStorage->load(torrentID);
-        if (resumeData)
+        QElapsedTimer addTorrentTimer;
+        addTorrentTimer.start();
+
+        for (const LoadedResumeData &loadedResumeDataItem : asConst(loadedResumeData))
         {
-            if (m_resumeDataStorage != startupStorage)
+            const TorrentID &torrentID = loadedResumeDataItem.torrentID;
+            const std::optional<LoadTorrentParams> &resumeData = loadedResumeDataItem.resumeData;
+            if (resumeData)
             {
-                m_resumeDataStorage->store(torrentID, *resumeData);
-                if (isQueueingSystemEnabled() && !resumeData->hasSeedStatus)
-                    queue.append(torrentID);
-            }
+                if (m_resumeDataStorage != startupStorage)
+                {
+                    m_resumeDataStorage->store(torrentID, *resumeData);
+                    if (isQueueingSystemEnabled() && !resumeData->hasSeedStatus)
+                        queue.append(torrentID);
+                }
+
+                qDebug() << "Starting up torrent" << torrentID.toString() << "...";
+                if (!loadTorrent(*resumeData))
+                    LogMsg(tr("Unable to resume torrent '%1'.", "e.g: Unable to resume torrent 'hash'.")
+                               .arg(torrentID.toString()), Log::CRITICAL);
 
-            qDebug() << "Starting up torrent" << torrentID.toString() << "...";
-            if (!loadTorrent(*resumeData))
+                ++resumedTorrentsCount;
+            }
+            else
+            {
                 LogMsg(tr("Unable to resume torrent '%1'.", "e.g: Unable to resume torrent 'hash'.")
                            .arg(torrentID.toString()), Log::CRITICAL);
+            }
+        }
 
-            // process add torrent messages before message queue overflow
-            if ((resumedTorrentsCount % 100) == 0) readAlerts();
+        // process add torrent messages before message queue overflow
+        readAlerts();
 
-            ++resumedTorrentsCount;
-        }
-        else
-        {
-            LogMsg(tr("Unable to resume torrent '%1'.", "e.g: Unable to resume torrent 'hash'.")
-                       .arg(torrentID.toString()), Log::CRITICAL);
-        }
+        addTorrentTime += addTorrentTimer.elapsed();
     }
 
+    const ResumeDataLoadStatistics loadStatistics = startupStorage->loadStatistics();
+    LogMsg(tr("Restored %1 torrents in %2 ms (reading: %3 ms, decoding: %4 ms, adding: %5 ms)."
+              , "Restored 100 torrents in 1500 ms (reading: 200 ms, decoding: 1000 ms, adding: 300 ms).")
+           .arg(QString::number(resumedTorrentsCount), QString::number(startupTimer.elapsed())
+                , QString::number(loadStatistics.readTime), QString::number(loadStatistics.decodeTime)
+                , QString::number(addTorrentTime)));
+
     if (m_resumeDataStorage != startupStorage)
     {
         delete startupStorage;
@@ -4323,8 +4468,71 @@ void Session::setTorrentContentLayout(const TorrentContentLayout value)
 void Session::readAlerts()
 {
     const std::vector<lt::alert *> alerts = getPendingAlerts();
-    for (const lt::alert *a : alerts)
-        handleAlert(a);
+
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+
+    QElapsedTimer alertTimer;
+    for (lt::alert *a : alerts)
+    {
+        alertTimer.start();
+        // torrent statuses are moved out of the alert instead of being copied
+        if (a->type() == lt::state_update_alert::alert_type)
+            handleStateUpdateAlert(static_cast<lt::state_update_alert *>(a));
+        else
+            handleAlert(a);
+
+        AlertTypeStatistics &typeStatistics = m_alertStatistics.types[a->type()];
+        typeStatistics.name = a->what();
+        ++typeStatistics.count;
+        typeStatistics.handlingTime += alertTimer.nsecsElapsed();
+    }
+
+    flushTrackerEvents();
+
+    m_alertStatistics.lastBatchSize = static_cast<int>(alerts.size());
+    m_alertStatistics.lastBatchHandlingTime = batchTimer.nsecsElapsed();
+}
+
+void Session::flushTrackerEvents()
+{
+    if (m_pendingTrackerEvents.isEmpty())
+        return;
+
+    const QHash<TorrentID, QHash<QString, TrackerEvent>> pendingTrackerEvents = std::exchange(m_pendingTrackerEvents, {});
+
+    QHash<Torrent *, QSet<QString>> updateInfos;
+    updateInfos.reserve(pendingTrackerEvents.size());
+    for (auto torrentIter = pendingTrackerEvents.cbegin(); torrentIter != pendingTrackerEvents.cend(); ++torrentIter)
+    {
+        TorrentImpl *torrent = m_torrents.value(torrentIter.key());
+        if (!torrent)
+            continue;
+
+        QSet<QString> &updatedTrackers = updateInfos[torrent];
+        const QHash<QString, TrackerEvent> &trackerEvents = torrentIter.value();
+        for (auto iter = trackerEvents.cbegin(); iter != trackerEvents.cend(); ++iter)
+        {
+            const QString &trackerUrl = iter.key();
+            updatedTrackers.insert(trackerUrl);
+
+            switch (iter.value())
+            {
+            case TrackerEvent::Success:
+                emit trackerSuccess(torrent, trackerUrl);
+                break;
+            case TrackerEvent::Warning:
+                emit trackerWarning(torrent, trackerUrl);
+                break;
+            case TrackerEvent::Error:
+                emit trackerError(torrent, trackerUrl);
+                break;
+            }
+        }
+    }
+
+    if (!updateInfos.isEmpty())
+        emit trackerEntriesUpdated(updateInfos);
 }
 
 void Session::handleAlert(const lt::alert *a)
@@ -4351,9 +4559,6 @@ void Session::handleAlert(const lt::alert *a)
         case lt::metadata_received_alert::alert_type:
             dispatchTorrentAlert(a);
             break;
-        case lt::state_update_alert::alert_type:
-            handleStateUpdateAlert(static_cast<const lt::state_update_alert*>(a));
-            break;
         case lt::session_stats_alert::alert_type:
             handleSessionStatsAlert(static_cast<const lt::session_stats_alert*>(a));
             break;
@@ -4476,9 +4681,8 @@ void Session::createTorrent(const lt::torrent_handle &nativeHandle)
             .arg(torrent->name()));
     }
 
-    if (((torrent->ratioLimit() >= 0) || (torrent->seedingTimeLimit() >= 0))
-        && !m_seedingLimitTimer->isActive())
-        m_seedingLimitTimer->start();
+    scheduleShareLimitsCheck(torrent);
+    updateSeedingLimitTimer();
 
     // Send torrent addition signal
     emit torrentLoaded(torrent);
@@ -4857,12 +5061,12 @@ void Session::handleStorageMovedFailedAlert(const lt::storage_moved_failed_alert
     handleMoveTorrentStorageJobFinished();
 }
 
-void Session::handleStateUpdateAlert(const lt::state_update_alert *p)
+void Session::handleStateUpdateAlert(lt::state_update_alert *p)
 {
     QVector<Torrent *> updatedTorrents;
     updatedTorrents.reserve(static_cast<decltype(updatedTorrents)::size_type>(p->status.size()));
 
-    for (const lt::torrent_status &status : p->status)
+    for (lt::torrent_status &status : p->status)
     {
 #if (LIBTORRENT_VERSION_NUM >= 20000)
         const auto id = TorrentID::fromInfoHash(status.info_hashes);
@@ -4873,12 +5077,16 @@ void Session::handleStateUpdateAlert(const lt::state_update_alert *p)
         if (!torrent)
             continue;
 
-        torrent->handleStateUpdate(status);
+        torrent->handleStateUpdate(std::move(status));
         updatedTorrents.push_back(torrent);
+        scheduleShareLimitsCheck(torrent);
     }
 
     if (!updatedTorrents.isEmpty())
+    {
+        updateSeedingLimitTimer();
         emit torrentsUpdated(updatedTorrents);
+    }
 
     if (m_refreshEnqueued)
         m_refreshEnqueued = false;
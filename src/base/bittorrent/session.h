@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <variant>
 #include <vector>
@@ -38,6 +39,7 @@
 #include <libtorrent/torrent_handle.hpp>
 #include <libtorrent/version.hpp>
 
+#include <QElapsedTimer>
 #include <QHash>
 #include <QPointer>
 #include <QSet>
@@ -65,6 +67,7 @@ class BandwidthScheduler;
 class FileSearcher;
 class FilterParserThread;
 class Statistics;
+class TorrentFilterIndex;
 
 // These values should remain unchanged when adding new items
 // so as not to break the existing user settings.
@@ -202,6 +205,20 @@ namespace BitTorrent
         } disk;
     };
 
+    struct AlertTypeStatistics
+    {
+        const char *name = nullptr;
+        qint64 count = 0;
+        qint64 handlingTime = 0;  // nanoseconds
+    };
+
+    struct AlertStatistics
+    {
+        int lastBatchSize = 0;
+        qint64 lastBatchHandlingTime = 0;  // nanoseconds
+        QHash<int, AlertTypeStatistics> types;  // by alert type
+    };
+
     class Session : public QObject
     {
         Q_OBJECT
@@ -445,11 +462,13 @@ namespace BitTorrent
         void startUpTorrents();
         Torrent *findTorrent(const TorrentID &id) const;
         QVector<Torrent *> torrents() const;
+        const TorrentFilterIndex *torrentFilterIndex() const;
         bool hasActiveTorrents() const;
         bool hasUnfinishedTorrents() const;
         bool hasRunningSeed() const;
         const SessionStatus &status() const;
         const CacheStatus &cacheStatus() const;
+        const AlertStatistics &alertStatistics() const;
         quint64 getAlltimeDL() const;
         quint64 getAlltimeUL() const;
         bool isListening() const;
@@ -477,7 +496,7 @@ namespace BitTorrent
         void handleTorrentNeedSaveResumeData(const TorrentImpl *torrent);
         void handleTorrentSaveResumeDataRequested(const TorrentImpl *torrent);
         void handleTorrentShareLimitChanged(TorrentImpl *const torrent);
-        void handleTorrentNameChanged(TorrentImpl *const torrent);
+        void handleTorrentChanged(TorrentImpl *const torrent);
         void handleTorrentSavePathChanged(TorrentImpl *const torrent);
         void handleTorrentCategoryChanged(TorrentImpl *const torrent, const QString &oldCategory);
         void handleTorrentTagAdded(TorrentImpl *const torrent, const QString &tag);
@@ -509,6 +528,7 @@ namespace BitTorrent
         void downloadFromUrlFailed(const QString &url, const QString &reason);
         void downloadFromUrlFinished(const QString &url);
         void fullDiskError(Torrent *torrent, const QString &msg);
+        void globalShareLimitsChanged();
         void IPFilterParsed(bool error, int ruleCount);
         void loadTorrentFailed(const QString &error);
         void metadataDownloaded(const TorrentInfo &info);
@@ -521,6 +541,7 @@ namespace BitTorrent
         void torrentAboutToBeRemoved(Torrent *torrent);
         void torrentAdded(Torrent *torrent);
         void torrentCategoryChanged(Torrent *torrent, const QString &oldCategory);
+        void torrentChanged(Torrent *torrent);
         void torrentFinished(Torrent *torrent);
         void torrentFinishedChecking(Torrent *torrent);
         void torrentLoaded(Torrent *torrent);
@@ -532,6 +553,7 @@ namespace BitTorrent
         void torrentsUpdated(const QVector<Torrent *> &torrents);
         void torrentTagAdded(Torrent *torrent, const QString &tag);
         void torrentTagRemoved(Torrent *torrent, const QString &tag);
+        void trackerEntriesUpdated(const QHash<Torrent *, QSet<QString>> &updateInfos);
         void trackerError(Torrent *torrent, const QString &tracker);
         void trackerlessStateChanged(Torrent *torrent, bool trackerless);
         void trackersAdded(Torrent *torrent, const QVector<TrackerEntry> &trackers);
@@ -575,9 +597,6 @@ namespace BitTorrent
         explicit Session(QObject *parent = nullptr);
         ~Session();
 
-        bool hasPerTorrentRatioLimit() const;
-        bool hasPerTorrentSeedingTimeLimit() const;
-
         // Session configuration
         Q_INVOKABLE void configure();
         void configureComponents();
@@ -606,13 +625,19 @@ namespace BitTorrent
         LoadTorrentParams initLoadTorrentParams(const AddTorrentParams &addTorrentParams);
         bool addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &source, const AddTorrentParams &addTorrentParams);
 
+        qint64 shareLimitsDueTime(const TorrentImpl *torrent) const;
+        void scheduleShareLimitsCheck(const TorrentImpl *torrent);
+        void unscheduleShareLimitsCheck(const TorrentID &id);
+        void rescheduleShareLimitsChecks();
+        void processTorrentShareLimits(TorrentImpl *torrent);
         void updateSeedingLimitTimer();
         void exportTorrentFile(const TorrentInfo &torrentInfo, const QString &folderPath, const QString &baseName);
 
         void handleAlert(const lt::alert *a);
         void dispatchTorrentAlert(const lt::alert *a);
         void handleAddTorrentAlert(const lt::add_torrent_alert *p);
-        void handleStateUpdateAlert(const lt::state_update_alert *p);
+        void handleStateUpdateAlert(lt::state_update_alert *p);
+        void flushTrackerEvents();
         void handleMetadataReceivedAlert(const lt::metadata_received_alert *p);
         void handleFileErrorAlert(const lt::file_error_alert *p);
         void handleTorrentRemovedAlert(const lt::torrent_removed_alert *p);
@@ -762,8 +787,13 @@ namespace BitTorrent
 
         bool m_refreshEnqueued = false;
         QTimer *m_seedingLimitTimer = nullptr;
+        // Seeding torrents ordered by the time they are expected to reach their share limits
+        QElapsedTimer m_shareLimitsClock;
+        std::multimap<qint64, TorrentID> m_shareLimitsQueue;
+        QHash<TorrentID, std::multimap<qint64, TorrentID>::iterator> m_shareLimitsQueueEntries;
         QTimer *m_resumeDataTimer = nullptr;
         Statistics *m_statistics = nullptr;
+        TorrentFilterIndex *m_torrentFilterIndex = nullptr;
         // IP filtering
         QPointer<FilterParserThread> m_filterParser;
         QPointer<BandwidthScheduler> m_bwScheduler;
@@ -793,6 +823,17 @@ namespace BitTorrent
 
         SessionStatus m_status;
         CacheStatus m_cacheStatus;
+        AlertStatistics m_alertStatistics;
+
+        enum class TrackerEvent
+        {
+            Success,
+            Warning,
+            Error
+        };
+        // Tracker events reported by the alerts being processed. Only the latest event
+        // of each tracker is kept, and they are reported once per batch of alerts.
+        QHash<TorrentID, QHash<QString, TrackerEvent>> m_pendingTrackerEvents;
 #if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
         QNetworkConfigurationManager *m_networkManager = nullptr;
 #endif
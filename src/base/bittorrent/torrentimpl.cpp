@@ -292,9 +292,12 @@ TorrentImpl::TorrentImpl(Session *session, lt::session *nativeSession
         // Initialize it only if torrent is added with metadata.
         // Otherwise it should be initialized in "Metadata received" handler.
         m_torrentInfo = TorrentInfo {m_nativeHandle.torrent_file()};
+        m_filePieceRanges = m_torrentInfo.filePieceRanges();
     }
 
-    initializeStatus(m_nativeStatus, m_ltAddTorrentParams);
+    lt::torrent_status nativeStatus;
+    initializeStatus(nativeStatus, m_ltAddTorrentParams);
+    storeStatus(std::move(nativeStatus));
     updateState();
 
     if (hasMetadata())
@@ -345,7 +348,7 @@ QString TorrentImpl::name() const
     if (hasMetadata())
         return m_torrentInfo.name();
 
-    const QString name = QString::fromStdString(m_nativeStatus.name);
+    const QString name = QString::fromStdString(m_nativeName);
     if (!name.isEmpty())
         return name;
 
@@ -380,12 +383,12 @@ qlonglong TorrentImpl::totalSize() const
 // size without the "don't download" files
 qlonglong TorrentImpl::wantedSize() const
 {
-    return m_nativeStatus.total_wanted;
+    return m_status.total_wanted;
 }
 
 qlonglong TorrentImpl::completedSize() const
 {
-    return m_nativeStatus.total_wanted_done;
+    return m_status.total_wanted_done;
 }
 
 qlonglong TorrentImpl::pieceLength() const
@@ -395,12 +398,12 @@ qlonglong TorrentImpl::pieceLength() const
 
 qlonglong TorrentImpl::wastedSize() const
 {
-    return (m_nativeStatus.total_failed_bytes + m_nativeStatus.total_redundant_bytes);
+    return (m_status.total_failed_bytes + m_status.total_redundant_bytes);
 }
 
 QString TorrentImpl::currentTracker() const
 {
-    return QString::fromStdString(m_nativeStatus.current_tracker);
+    return QString::fromStdString(m_currentTracker);
 }
 
 QString TorrentImpl::savePath(bool actual) const
@@ -457,7 +460,7 @@ void TorrentImpl::setAutoTMMEnabled(bool enabled)
 
 QString TorrentImpl::actualStorageLocation() const
 {
-    return QString::fromStdString(m_nativeStatus.save_path);
+    return QString::fromStdString(m_actualSavePath);
 }
 
 void TorrentImpl::setAutoManaged(const bool enable)
@@ -666,21 +669,21 @@ int TorrentImpl::piecesCount() const
 
 int TorrentImpl::piecesHave() const
 {
-    return m_nativeStatus.num_pieces;
+    return m_status.num_pieces;
 }
 
 qreal TorrentImpl::progress() const
 {
     if (isChecking())
-        return m_nativeStatus.progress;
+        return m_status.progress;
 
-    if (m_nativeStatus.total_wanted == 0)
+    if (m_status.total_wanted == 0)
         return 0.;
 
-    if (m_nativeStatus.total_wanted_done == m_nativeStatus.total_wanted)
+    if (m_status.total_wanted_done == m_status.total_wanted)
         return 1.;
 
-    const qreal progress = static_cast<qreal>(m_nativeStatus.total_wanted_done) / m_nativeStatus.total_wanted;
+    const qreal progress = static_cast<qreal>(m_status.total_wanted_done) / m_status.total_wanted;
     Q_ASSERT((progress >= 0.f) && (progress <= 1.f));
     return progress;
 }
@@ -750,7 +753,7 @@ void TorrentImpl::removeAllTags()
 
 QDateTime TorrentImpl::addedTime() const
 {
-    return QDateTime::fromSecsSinceEpoch(m_nativeStatus.added_time);
+    return QDateTime::fromSecsSinceEpoch(m_status.added_time);
 }
 
 qreal TorrentImpl::ratioLimit() const
@@ -818,14 +821,14 @@ bool TorrentImpl::isQueued() const
 {
     // Torrent is Queued if it isn't in Paused state but paused internally
     return (!isPaused()
-            && (m_nativeStatus.flags & lt::torrent_flags::auto_managed)
-            && (m_nativeStatus.flags & lt::torrent_flags::paused));
+            && (m_status.flags & lt::torrent_flags::auto_managed)
+            && (m_status.flags & lt::torrent_flags::paused));
 }
 
 bool TorrentImpl::isChecking() const
 {
-    return ((m_nativeStatus.state == lt::torrent_status::checking_files)
-            || (m_nativeStatus.state == lt::torrent_status::checking_resume_data));
+    return ((m_status.state == lt::torrent_status::checking_files)
+            || (m_status.state == lt::torrent_status::checking_resume_data));
 }
 
 bool TorrentImpl::isDownloading() const
@@ -884,8 +887,8 @@ bool TorrentImpl::isErrored() const
 
 bool TorrentImpl::isSeed() const
 {
-    return ((m_nativeStatus.state == lt::torrent_status::finished)
-            || (m_nativeStatus.state == lt::torrent_status::seeding));
+    return ((m_status.state == lt::torrent_status::finished)
+            || (m_status.state == lt::torrent_status::seeding));
 }
 
 bool TorrentImpl::isForced() const
@@ -895,7 +898,7 @@ bool TorrentImpl::isForced() const
 
 bool TorrentImpl::isSequentialDownload() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::sequential_download);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::sequential_download);
 }
 
 bool TorrentImpl::hasFirstLastPiecePriority() const
@@ -910,7 +913,7 @@ TorrentState TorrentImpl::state() const
 
 void TorrentImpl::updateState()
 {
-    if (m_nativeStatus.state == lt::torrent_status::checking_resume_data)
+    if (m_status.state == lt::torrent_status::checking_resume_data)
     {
         m_state = TorrentState::CheckingResumeData;
     }
@@ -935,9 +938,9 @@ void TorrentImpl::updateState()
         else
             m_state = TorrentState::DownloadingMetadata;
     }
-    else if ((m_nativeStatus.state == lt::torrent_status::checking_files)
-             && (!isPaused() || (m_nativeStatus.flags & lt::torrent_flags::auto_managed)
-                 || !(m_nativeStatus.flags & lt::torrent_flags::paused)))
+    else if ((m_status.state == lt::torrent_status::checking_files)
+             && (!isPaused() || (m_status.flags & lt::torrent_flags::auto_managed)
+                 || !(m_status.flags & lt::torrent_flags::paused)))
     {
         // If the torrent is not just in the "checking" state, but is being actually checked
         m_state = m_hasSeedStatus ? TorrentState::CheckingUploading : TorrentState::CheckingDownloading;
@@ -950,7 +953,7 @@ void TorrentImpl::updateState()
             m_state = TorrentState::QueuedUploading;
         else if (isForced())
             m_state = TorrentState::ForcedUploading;
-        else if (m_nativeStatus.upload_payload_rate > 0)
+        else if (m_status.upload_payload_rate > 0)
             m_state = TorrentState::Uploading;
         else
             m_state = TorrentState::StalledUploading;
@@ -963,7 +966,7 @@ void TorrentImpl::updateState()
             m_state = TorrentState::QueuedDownloading;
         else if (isForced())
             m_state = TorrentState::ForcedDownloading;
-        else if (m_nativeStatus.download_payload_rate > 0)
+        else if (m_status.download_payload_rate > 0)
             m_state = TorrentState::Downloading;
         else
             m_state = TorrentState::StalledDownloading;
@@ -982,7 +985,7 @@ bool TorrentImpl::hasMissingFiles() const
 
 bool TorrentImpl::hasError() const
 {
-    return (m_nativeStatus.errc || (m_nativeStatus.flags & lt::torrent_flags::upload_mode));
+    return (m_status.errc || (m_status.flags & lt::torrent_flags::upload_mode));
 }
 
 bool TorrentImpl::hasFilteredPieces() const
@@ -996,15 +999,15 @@ bool TorrentImpl::hasFilteredPieces() const
 
 int TorrentImpl::queuePosition() const
 {
-    return static_cast<int>(m_nativeStatus.queue_position);
+    return static_cast<int>(m_status.queue_position);
 }
 
 QString TorrentImpl::error() const
 {
-    if (m_nativeStatus.errc)
-        return QString::fromStdString(m_nativeStatus.errc.message());
+    if (m_status.errc)
+        return QString::fromStdString(m_status.errc.message());
 
-    if (m_nativeStatus.flags & lt::torrent_flags::upload_mode)
+    if (m_status.flags & lt::torrent_flags::upload_mode)
     {
         const QString writeErrorStr = tr("Couldn't write to file.");
         const QString uploadModeStr = tr("Torrent is currently in \"upload only\" mode.");
@@ -1018,27 +1021,27 @@ QString TorrentImpl::error() const
 
 qlonglong TorrentImpl::totalDownload() const
 {
-    return m_nativeStatus.all_time_download;
+    return m_status.all_time_download;
 }
 
 qlonglong TorrentImpl::totalUpload() const
 {
-    return m_nativeStatus.all_time_upload;
+    return m_status.all_time_upload;
 }
 
 qlonglong TorrentImpl::activeTime() const
 {
-    return lt::total_seconds(m_nativeStatus.active_duration);
+    return lt::total_seconds(m_status.active_duration);
 }
 
 qlonglong TorrentImpl::finishedTime() const
 {
-    return lt::total_seconds(m_nativeStatus.finished_duration);
+    return lt::total_seconds(m_status.finished_duration);
 }
 
 qlonglong TorrentImpl::seedingTime() const
 {
-    return lt::total_seconds(m_nativeStatus.seeding_duration);
+    return lt::total_seconds(m_status.seeding_duration);
 }
 
 qlonglong TorrentImpl::eta() const
@@ -1083,6 +1086,14 @@ qlonglong TorrentImpl::eta() const
 }
 
 QVector<qreal> TorrentImpl::filesProgress() const
+{
+    if (m_filesProgress.isEmpty())
+        m_filesProgress = fetchFilesProgress();
+
+    return m_filesProgress;
+}
+
+QVector<qreal> TorrentImpl::fetchFilesProgress() const
 {
     if (!hasMetadata())
         return {};
@@ -1107,75 +1118,75 @@ QVector<qreal> TorrentImpl::filesProgress() const
 
 int TorrentImpl::seedsCount() const
 {
-    return m_nativeStatus.num_seeds;
+    return m_status.num_seeds;
 }
 
 int TorrentImpl::peersCount() const
 {
-    return m_nativeStatus.num_peers;
+    return m_status.num_peers;
 }
 
 int TorrentImpl::leechsCount() const
 {
-    return (m_nativeStatus.num_peers - m_nativeStatus.num_seeds);
+    return (m_status.num_peers - m_status.num_seeds);
 }
 
 int TorrentImpl::totalSeedsCount() const
 {
-    return (m_nativeStatus.num_complete > 0) ? m_nativeStatus.num_complete : m_nativeStatus.list_seeds;
+    return (m_status.num_complete > 0) ? m_status.num_complete : m_status.list_seeds;
 }
 
 int TorrentImpl::totalPeersCount() const
 {
-    const int peers = m_nativeStatus.num_complete + m_nativeStatus.num_incomplete;
-    return (peers > 0) ? peers : m_nativeStatus.list_peers;
+    const int peers = m_status.num_complete + m_status.num_incomplete;
+    return (peers > 0) ? peers : m_status.list_peers;
 }
 
 int TorrentImpl::totalLeechersCount() const
 {
-    return (m_nativeStatus.num_incomplete > 0) ? m_nativeStatus.num_incomplete : (m_nativeStatus.list_peers - m_nativeStatus.list_seeds);
+    return (m_status.num_incomplete > 0) ? m_status.num_incomplete : (m_status.list_peers - m_status.list_seeds);
 }
 
 int TorrentImpl::completeCount() const
 {
     // additional info: https://github.com/qbittorrent/qBittorrent/pull/5300#issuecomment-267783646
-    return m_nativeStatus.num_complete;
+    return m_status.num_complete;
 }
 
 int TorrentImpl::incompleteCount() const
 {
     // additional info: https://github.com/qbittorrent/qBittorrent/pull/5300#issuecomment-267783646
-    return m_nativeStatus.num_incomplete;
+    return m_status.num_incomplete;
 }
 
 QDateTime TorrentImpl::lastSeenComplete() const
 {
-    if (m_nativeStatus.last_seen_complete > 0)
-        return QDateTime::fromSecsSinceEpoch(m_nativeStatus.last_seen_complete);
+    if (m_status.last_seen_complete > 0)
+        return QDateTime::fromSecsSinceEpoch(m_status.last_seen_complete);
     else
         return {};
 }
 
 QDateTime TorrentImpl::completedTime() const
 {
-    if (m_nativeStatus.completed_time > 0)
-        return QDateTime::fromSecsSinceEpoch(m_nativeStatus.completed_time);
+    if (m_status.completed_time > 0)
+        return QDateTime::fromSecsSinceEpoch(m_status.completed_time);
     else
         return {};
 }
 
 qlonglong TorrentImpl::timeSinceUpload() const
 {
-    if (m_nativeStatus.last_upload.time_since_epoch().count() == 0)
+    if (m_status.last_upload.time_since_epoch().count() == 0)
         return -1;
-    return lt::total_seconds(lt::clock_type::now() - m_nativeStatus.last_upload);
+    return lt::total_seconds(lt::clock_type::now() - m_status.last_upload);
 }
 
 qlonglong TorrentImpl::timeSinceDownload() const
 {
-    if (m_nativeStatus.last_download.time_since_epoch().count() == 0)
+    if (m_status.last_download.time_since_epoch().count() == 0)
         return -1;
-    return lt::total_seconds(lt::clock_type::now() - m_nativeStatus.last_download);
+    return lt::total_seconds(lt::clock_type::now() - m_status.last_download);
 }
 
 qlonglong TorrentImpl::timeSinceActivity() const
@@ -1199,22 +1210,22 @@ int TorrentImpl::uploadLimit() const
 
 bool TorrentImpl::superSeeding() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::super_seeding);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::super_seeding);
 }
 
 bool TorrentImpl::isDHTDisabled() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::disable_dht);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::disable_dht);
 }
 
 bool TorrentImpl::isPEXDisabled() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::disable_pex);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::disable_pex);
 }
 
 bool TorrentImpl::isLSDDisabled() const
 {
-    return static_cast<bool>(m_nativeStatus.flags & lt::torrent_flags::disable_lsd);
+    return static_cast<bool>(m_status.flags & lt::torrent_flags::disable_lsd);
 }
 
 QVector<PeerInfo> TorrentImpl::peers() const
@@ -1233,10 +1244,10 @@ QVector<PeerInfo> TorrentImpl::peers() const
 
 QBitArray TorrentImpl::pieces() const
 {
-    QBitArray result(m_nativeStatus.pieces.size());
+    QBitArray result(m_pieces.size());
     for (int i = 0; i < result.size(); ++i)
     {
-        if (m_nativeStatus.pieces[lt::piece_index_t {i}])
+        if (m_pieces[lt::piece_index_t {i}])
             result.setBit(i, true);
     }
     return result;
@@ -1265,7 +1276,7 @@ QVector<int> TorrentImpl::pieceAvailability() const
 
 qreal TorrentImpl::distributedCopies() const
 {
-    return m_nativeStatus.distributed_copies;
+    return m_status.distributed_copies;
 }
 
 qreal TorrentImpl::maxRatio() const
@@ -1286,11 +1297,11 @@ int TorrentImpl::maxSeedingTime() const
 
 qreal TorrentImpl::realRatio() const
 {
-    const int64_t upload = m_nativeStatus.all_time_upload;
+    const int64_t upload = m_status.all_time_upload;
     // special case for a seeder who lost its stats, also assume nobody will import a 99% done torrent
-    const int64_t download = (m_nativeStatus.all_time_download < (m_nativeStatus.total_done * 0.01))
-        ? m_nativeStatus.total_done
-        : m_nativeStatus.all_time_download;
+    const int64_t download = (m_status.all_time_download < (m_status.total_done * 0.01))
+        ? m_status.total_done
+        : m_status.all_time_download;
 
     if (download == 0)
         return (upload == 0) ? 0 : MAX_RATIO;
@@ -1302,37 +1313,37 @@ qreal TorrentImpl::realRatio() const
 
 int TorrentImpl::uploadPayloadRate() const
 {
-    return m_nativeStatus.upload_payload_rate;
+    return m_status.upload_payload_rate;
 }
 
 int TorrentImpl::downloadPayloadRate() const
 {
-    return m_nativeStatus.download_payload_rate;
+    return m_status.download_payload_rate;
 }
 
 qlonglong TorrentImpl::totalPayloadUpload() const
 {
-    return m_nativeStatus.total_payload_upload;
+    return m_status.total_payload_upload;
 }
 
 qlonglong TorrentImpl::totalPayloadDownload() const
 {
-    return m_nativeStatus.total_payload_download;
+    return m_status.total_payload_download;
 }
 
 int TorrentImpl::connectionsCount() const
 {
-    return m_nativeStatus.num_connections;
+    return m_status.num_connections;
 }
 
 int TorrentImpl::connectionsLimit() const
 {
-    return m_nativeStatus.connections_limit;
+    return m_status.connections_limit;
 }
 
 qlonglong TorrentImpl::nextAnnounce() const
 {
-    return lt::total_seconds(m_nativeStatus.next_announce);
+    return lt::total_seconds(m_status.next_announce);
 }
 
 void TorrentImpl::setName(const QString &name)
@@ -1341,7 +1352,7 @@ void TorrentImpl::setName(const QString &name)
     {
         m_name = name;
         m_session->handleTorrentNeedSaveResumeData(this);
-        m_session->handleTorrentNameChanged(this);
+        m_session->handleTorrentChanged(this);
     }
 }
 
@@ -1435,15 +1446,16 @@ void TorrentImpl::setSequentialDownload(const bool enable)
     if (enable)
     {
         m_nativeHandle.set_flags(lt::torrent_flags::sequential_download);
-        m_nativeStatus.flags |= lt::torrent_flags::sequential_download;  // prevent return cached value
+        m_status.flags |= lt::torrent_flags::sequential_download;  // prevent return cached value
     }
     else
     {
         m_nativeHandle.unset_flags(lt::torrent_flags::sequential_download);
-        m_nativeStatus.flags &= ~lt::torrent_flags::sequential_download;  // prevent return cached value
+        m_status.flags &= ~lt::torrent_flags::sequential_download;  // prevent return cached value
     }
 
     m_session->handleTorrentNeedSaveResumeData(this);
+    m_session->handleTorrentChanged(this);
 }
 
 void TorrentImpl::setFirstLastPiecePriority(const bool enabled)
@@ -1459,6 +1471,7 @@ void TorrentImpl::setFirstLastPiecePriority(const bool enabled)
         .arg((enabled ? tr("On") : tr("Off")), name()));
 
     m_session->handleTorrentNeedSaveResumeData(this);
+    m_session->handleTorrentChanged(this);
 }
 
 void TorrentImpl::applyFirstLastPiecePriority(const bool enabled, const QVector<DownloadPriority> &updatedFilePrio)
@@ -1552,6 +1565,9 @@ void TorrentImpl::reload()
     m_nativeHandle.queue_position_set(queuePos);
 
     m_torrentInfo = TorrentInfo {m_nativeHandle.torrent_file()};
+    m_filePieceRanges = m_torrentInfo.filePieceRanges();
+    m_filesProgress.clear();
+    m_availableFileFractions.clear();
 }
 
 void TorrentImpl::pause()
@@ -1628,9 +1644,9 @@ void TorrentImpl::renameFile(const int index, const QString &path)
     m_nativeHandle.rename_file(lt::file_index_t {index}, Utils::Fs::toNativePath(path).toStdString());
 }
 
-void TorrentImpl::handleStateUpdate(const lt::torrent_status &nativeStatus)
+void TorrentImpl::handleStateUpdate(lt::torrent_status &&nativeStatus)
 {
-    updateStatus(nativeStatus);
+    updateStatus(std::move(nativeStatus));
 }
 
 void TorrentImpl::handleMoveStorageJobFinished(const bool hasOutstandingJob)
@@ -1639,7 +1655,7 @@ void TorrentImpl::handleMoveStorageJobFinished(const bool hasOutstandingJob)
     m_storageIsMoving = hasOutstandingJob;
 
     updateStatus();
-    const QString newPath = QString::fromStdString(m_nativeStatus.save_path);
+    const QString newPath = QString::fromStdString(m_actualSavePath);
     if (!useTempPath() && (newPath != m_savePath))
     {
         m_savePath = newPath;
@@ -1652,7 +1668,7 @@ void TorrentImpl::handleMoveStorageJobFinished(const bool hasOutstandingJob)
         {
             // it can be moved to the proper location
             m_hasMissingFiles = false;
-            m_ltAddTorrentParams.save_path = m_nativeStatus.save_path;
+            m_ltAddTorrentParams.save_path = m_actualSavePath;
             m_ltAddTorrentParams.ti = std::const_pointer_cast<lt::torrent_info>(m_nativeHandle.torrent_file());
             reload();
             updateStatus();
@@ -2039,7 +2055,7 @@ void TorrentImpl::handleAlert(const lt::alert *a)
 void TorrentImpl::manageIncompleteFiles()
 {
     const bool isAppendExtensionEnabled = m_session->isAppendExtensionEnabled();
-    const QVector<qreal> fp = filesProgress();
+    const QVector<qreal> fp = fetchFilesProgress();
     if (fp.size() != filesCount())
     {
         qDebug() << "skip manageIncompleteFiles because of invalid torrent meta-data or empty file-progress";
@@ -2126,13 +2142,63 @@ void TorrentImpl::updateStatus()
     updateStatus(m_nativeHandle.status());
 }
 
-void TorrentImpl::updateStatus(const lt::torrent_status &nativeStatus)
-{
-    m_nativeStatus = nativeStatus;
+void TorrentImpl::storeStatus(lt::torrent_status &&nativeStatus)
+{
+    m_status.flags = nativeStatus.flags;
+    m_status.state = nativeStatus.state;
+    m_status.errc = nativeStatus.errc;
+    m_status.queue_position = nativeStatus.queue_position;
+
+    m_status.progress = nativeStatus.progress;
+    m_status.distributed_copies = nativeStatus.distributed_copies;
+    m_status.download_payload_rate = nativeStatus.download_payload_rate;
+    m_status.upload_payload_rate = nativeStatus.upload_payload_rate;
+    m_status.num_pieces = nativeStatus.num_pieces;
+    m_status.num_seeds = nativeStatus.num_seeds;
+    m_status.num_peers = nativeStatus.num_peers;
+    m_status.num_complete = nativeStatus.num_complete;
+    m_status.num_incomplete = nativeStatus.num_incomplete;
+    m_status.list_seeds = nativeStatus.list_seeds;
+    m_status.list_peers = nativeStatus.list_peers;
+    m_status.num_connections = nativeStatus.num_connections;
+    m_status.connections_limit = nativeStatus.connections_limit;
+
+    m_status.total_done = nativeStatus.total_done;
+    m_status.total_wanted = nativeStatus.total_wanted;
+    m_status.total_wanted_done = nativeStatus.total_wanted_done;
+    m_status.total_failed_bytes = nativeStatus.total_failed_bytes;
+    m_status.total_redundant_bytes = nativeStatus.total_redundant_bytes;
+    m_status.total_payload_download = nativeStatus.total_payload_download;
+    m_status.total_payload_upload = nativeStatus.total_payload_upload;
+    m_status.all_time_download = nativeStatus.all_time_download;
+    m_status.all_time_upload = nativeStatus.all_time_upload;
+
+    m_status.added_time = nativeStatus.added_time;
+    m_status.completed_time = nativeStatus.completed_time;
+    m_status.last_seen_complete = nativeStatus.last_seen_complete;
+    m_status.last_download = nativeStatus.last_download;
+    m_status.last_upload = nativeStatus.last_upload;
+    m_status.active_duration = nativeStatus.active_duration;
+    m_status.finished_duration = nativeStatus.finished_duration;
+    m_status.seeding_duration = nativeStatus.seeding_duration;
+    m_status.next_announce = nativeStatus.next_announce;
+
+    // The rest is taken over without copying
+    m_nativeName = std::move(nativeStatus.name);
+    m_currentTracker = std::move(nativeStatus.current_tracker);
+    m_actualSavePath = std::move(nativeStatus.save_path);
+    m_pieces = std::move(nativeStatus.pieces);
+}
+
+void TorrentImpl::updateStatus(lt::torrent_status nativeStatus)
+{
+    storeStatus(std::move(nativeStatus));
+    m_filesProgress.clear();
+    m_availableFileFractions.clear();
     updateState();
 
-    m_speedMonitor.addSample({nativeStatus.download_payload_rate
-                              , nativeStatus.upload_payload_rate});
+    m_speedMonitor.addSample({m_status.download_payload_rate
+                              , m_status.upload_payload_rate});
 
     if (hasMetadata())
     {
@@ -2182,6 +2248,7 @@ void TorrentImpl::setUploadLimit(const int limit)
 
     m_nativeHandle.set_upload_limit(limit);
     m_session->handleTorrentNeedSaveResumeData(this);
+    m_session->handleTorrentChanged(this);
 }
 
 void TorrentImpl::setDownloadLimit(const int limit)
@@ -2191,6 +2258,7 @@ void TorrentImpl::setDownloadLimit(const int limit)
 
     m_nativeHandle.set_download_limit(limit);
     m_session->handleTorrentNeedSaveResumeData(this);
+    m_session->handleTorrentChanged(this);
 }
 
 void TorrentImpl::setSuperSeeding(const bool enable)
@@ -2199,11 +2267,18 @@ void TorrentImpl::setSuperSeeding(const bool enable)
         return;
 
     if (enable)
+    {
         m_nativeHandle.set_flags(lt::torrent_flags::super_seeding);
+        m_status.flags |= lt::torrent_flags::super_seeding;  // prevent return cached value
+    }
     else
+    {
         m_nativeHandle.unset_flags(lt::torrent_flags::super_seeding);
+        m_status.flags &= ~lt::torrent_flags::super_seeding;  // prevent return cached value
+    }
 
     m_session->handleTorrentNeedSaveResumeData(this);
+    m_session->handleTorrentChanged(this);
 }
 
 void TorrentImpl::setDHTDisabled(const bool disable)
@@ -2262,7 +2337,7 @@ void TorrentImpl::prioritizeFiles(const QVector<DownloadPriority> &priorities)
 
     // Reset 'm_hasSeedStatus' if needed in order to react again to
     // 'torrent_finished_alert' and eg show tray notifications
-    const QVector<qreal> progress = filesProgress();
+    const QVector<qreal> progress = fetchFilesProgress();
     const QVector<DownloadPriority> oldPriorities = filePriorities();
     for (int i = 0; i < oldPriorities.size(); ++i)
     {
@@ -2285,28 +2360,39 @@ void TorrentImpl::prioritizeFiles(const QVector<DownloadPriority> &priorities)
 
 QVector<qreal> TorrentImpl::availableFileFractions() const
 {
+    if (!m_availableFileFractions.isEmpty())
+        return m_availableFileFractions;
+
     const int filesCount = this->filesCount();
     if (filesCount <= 0) return {};
 
-    const QVector<int> piecesAvailability = pieceAvailability();
+    std::vector<int> piecesAvailability;
+    m_nativeHandle.piece_availability(piecesAvailability);
     // libtorrent returns empty array for seeding only torrents
     if (piecesAvailability.empty()) return QVector<qreal>(filesCount, -1);
 
+    // availablePiecesBefore[i] holds the number of available pieces in [0, i),
+    // so the count for any file is a difference of two entries
+    const int piecesCount = static_cast<int>(piecesAvailability.size());
+    std::vector<int> availablePiecesBefore(piecesCount + 1, 0);
+    for (int i = 0; i < piecesCount; ++i)
+        availablePiecesBefore[i + 1] = availablePiecesBefore[i] + ((piecesAvailability[i] > 0) ? 1 : 0);
+
     QVector<qreal> res;
     res.reserve(filesCount);
-    const TorrentInfo info = this->info();
-    for (int i = 0; i < filesCount; ++i)
+    for (const TorrentInfo::PieceRange &filePieces : asConst(m_filePieceRanges))
     {
-        const TorrentInfo::PieceRange filePieces = info.filePieces(i);
-
-        int availablePieces = 0;
-        for (const int piece : filePieces)
-            availablePieces += (piecesAvailability[piece] > 0) ? 1 : 0;
+        if (filePieces.isEmpty())
+        {
+            // the file has no pieces, so it is available by default
+            res.push_back(1);
+            continue;
+        }
 
-        const qreal availability = filePieces.isEmpty()
-            ? 1  // the file has no pieces, so it is available by default
-            : static_cast<qreal>(availablePieces) / filePieces.size();
-        res.push_back(availability);
+        const int availablePieces = availablePiecesBefore[filePieces.last() + 1] - availablePiecesBefore[filePieces.first()];
+        res.push_back(static_cast<qreal>(availablePieces) / filePieces.size());
     }
+
+    m_availableFileFractions = res;
     return res;
 }
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <ctime>
 #include <functional>
+#include <string>
 
 #include <libtorrent/add_torrent_params.hpp>
 #include <libtorrent/fwd.hpp>
@@ -232,7 +235,7 @@ namespace BitTorrent
         lt::torrent_handle nativeHandle() const;
 
         void handleAlert(const lt::alert *a);
-        void handleStateUpdate(const lt::torrent_status &nativeStatus);
+        void handleStateUpdate(lt::torrent_status &&nativeStatus);
         void handleTempPathChanged();
         void handleCategorySavePathChanged();
         void handleAppendExtensionToggled();
@@ -245,9 +248,55 @@ namespace BitTorrent
     private:
         using EventTrigger = std::function<void ()>;
 
+        // Plain copy of the lt::torrent_status fields the accessors read.
+        // Refreshing it doesn't allocate, unlike copying lt::torrent_status.
+        struct Status
+        {
+            lt::torrent_flags_t flags;
+            lt::torrent_status::state_t state = lt::torrent_status::checking_resume_data;
+            lt::error_code errc;
+            lt::queue_position_t queue_position {-1};
+
+            float progress = 0;
+            float distributed_copies = 0;
+            int download_payload_rate = 0;
+            int upload_payload_rate = 0;
+            int num_pieces = 0;
+            int num_seeds = 0;
+            int num_peers = 0;
+            int num_complete = -1;
+            int num_incomplete = -1;
+            int list_seeds = 0;
+            int list_peers = 0;
+            int num_connections = 0;
+            int connections_limit = 0;
+
+            std::int64_t total_done = 0;
+            std::int64_t total_wanted = 0;
+            std::int64_t total_wanted_done = 0;
+            std::int64_t total_failed_bytes = 0;
+            std::int64_t total_redundant_bytes = 0;
+            std::int64_t total_payload_download = 0;
+            std::int64_t total_payload_upload = 0;
+            std::int64_t all_time_download = 0;
+            std::int64_t all_time_upload = 0;
+
+            std::time_t added_time = 0;
+            std::time_t completed_time = 0;
+            std::time_t last_seen_complete = 0;
+            lt::time_point last_download;
+            lt::time_point last_upload;
+            lt::seconds active_duration {0};
+            lt::seconds finished_duration {0};
+            lt::seconds seeding_duration {0};
+            lt::seconds next_announce {0};
+        };
+
+        void storeStatus(lt::torrent_status &&nativeStatus);
         void updateStatus();
-        void updateStatus(const lt::torrent_status &nativeStatus);
+        void updateStatus(lt::torrent_status nativeStatus);
         void updateState();
+        QVector<qreal> fetchFilesProgress() const;
 
         void handleFastResumeRejectedAlert(const lt::fastresume_rejected_alert *p);
         void handleFileCompletedAlert(const lt::file_completed_alert *p);
@@ -287,9 +336,17 @@ namespace BitTorrent
         Session *const m_session;
         lt::session *m_nativeSession;
         lt::torrent_handle m_nativeHandle;
-        lt::torrent_status m_nativeStatus;
+        Status m_status;
+        std::string m_nativeName;
+        std::string m_currentTracker;
+        std::string m_actualSavePath;
+        lt::typed_bitfield<lt::piece_index_t> m_pieces;
         TorrentState m_state = TorrentState::Unknown;
         TorrentInfo m_torrentInfo;
+        QVector<TorrentInfo::PieceRange> m_filePieceRanges;
+        // Per file data is computed on demand and kept until the next status update
+        mutable QVector<qreal> m_filesProgress;
+        mutable QVector<qreal> m_availableFileFractions;
         SpeedMonitor m_speedMonitor;
 
         InfoHash m_infoHash;
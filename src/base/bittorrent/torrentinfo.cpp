@@ -73,6 +73,20 @@ namespace
 
         return rootFolder;
     }
+
+    TorrentInfo::PieceRange piecesForFile(const lt::file_storage &files, const int fileIndex)
+    {
+        const qint64 fileSize = files.file_size(lt::file_index_t {fileIndex});
+        const qint64 fileOffset = files.file_offset(lt::file_index_t {fileIndex});
+        const int pieceLength = files.piece_length();
+
+        const int beginIdx = (fileOffset / pieceLength);
+        const int endIdx = ((fileOffset + fileSize - 1) / pieceLength);
+
+        if (fileSize <= 0)
+            return {beginIdx, 0};
+        return makeInterval(beginIdx, endIdx);
+    }
 }
 
 const int torrentInfoId = qRegisterMetaType<TorrentInfo>();
@@ -418,16 +432,23 @@ TorrentInfo::PieceRange TorrentInfo::filePieces(const int fileIndex) const
         return {};
     }
 
+    return piecesForFile(nativeInfo()->files(), fileIndex);
+}
+
+QVector<TorrentInfo::PieceRange> TorrentInfo::filePieceRanges() const
+{
+    if (!isValid())
+        return {};
+
     const lt::file_storage &files = nativeInfo()->files();
-    const auto fileSize = files.file_size(lt::file_index_t {fileIndex});
-    const auto fileOffset = files.file_offset(lt::file_index_t {fileIndex});
+    const int count = filesCount();
 
-    const int beginIdx = (fileOffset / pieceLength());
-    const int endIdx = ((fileOffset + fileSize - 1) / pieceLength());
+    QVector<PieceRange> res;
+    res.reserve(count);
+    for (int i = 0; i < count; ++i)
+        res.append(piecesForFile(files, i));
 
-    if (fileSize <= 0)
-        return {beginIdx, 0};
-    return makeInterval(beginIdx, endIdx);
+    return res;
 }
 
 void TorrentInfo::renameFile(const int index, const QString &newPath)
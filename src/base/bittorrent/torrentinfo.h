@@ -91,6 +91,9 @@ namespace BitTorrent
         // the given file extends (maybe partially).
         PieceRange filePieces(const QString &file) const;
         PieceRange filePieces(int fileIndex) const;
+        // returns piece ranges of all the files at once,
+        // indexed the same way as the files themselves
+        QVector<PieceRange> filePieceRanges() const;
 
         void renameFile(int index, const QString &newPath) override;
 
@@ -59,16 +59,20 @@ void Connection::read()
     m_idleTimer.restart();
     m_receivedData.append(m_socket->readAll());
 
-    while (!m_receivedData.isEmpty())
+    // Processed requests are skipped by moving the offset, the rest of data is moved
+    // to the beginning of the buffer only once all the complete requests are processed
+    int offset = 0;
+    while (offset < m_receivedData.size())
     {
-        const RequestParser::ParseResult result = RequestParser::parse(m_receivedData);
+        const QByteArray data = QByteArray::fromRawData((m_receivedData.constData() + offset), (m_receivedData.size() - offset));
+        const RequestParser::ParseResult result = m_requestParser.parse(data);
 
         switch (result.status)
         {
         case RequestParser::ParseStatus::Incomplete:
         {
                 const long bufferLimit = RequestParser::MAX_CONTENT_SIZE * 1.1;  // some margin for headers
-                if (m_receivedData.size() > bufferLimit)
+                if (data.size() > bufferLimit)
                 {
                     Logger::instance()->addMessage(tr("Http request size exceeds limitation, closing socket. Limit: %1, IP: %2")
                         .arg(bufferLimit).arg(m_socket->peerAddress().toString()), Log::WARNING);
@@ -78,7 +82,11 @@ void Connection::read()
 
                     sendResponse(resp);
                     m_socket->close();
+                    m_receivedData.clear();
+                    return;
                 }
+
+                m_receivedData.remove(0, offset);
             }
             return;
 
@@ -92,6 +100,7 @@ void Connection::read()
 
                 sendResponse(resp);
                 m_socket->close();
+                m_receivedData.clear();
             }
             return;
 
@@ -101,13 +110,13 @@ void Connection::read()
 
                 Response resp = m_requestHandler->processRequest(result.request, env);
 
-                if (acceptsGzipEncoding(result.request.headers["accept-encoding"]))
+                if (acceptsGzipEncoding(result.request.headers[HEADER_ACCEPT_ENCODING]))
                     resp.headers[HEADER_CONTENT_ENCODING] = "gzip";
 
                 resp.headers[HEADER_CONNECTION] = "keep-alive";
 
                 sendResponse(resp);
-                m_receivedData = m_receivedData.mid(result.frameSize);
+                offset += result.frameSize;
             }
             break;
 
@@ -116,6 +125,8 @@ void Connection::read()
             return;
         }
     }
+
+    m_receivedData.clear();
 }
 
 void Connection::sendResponse(const Response &response) const
@@ -132,46 +143,3 @@ bool Connection::isClosed() const
 {
     return (m_socket->state() == QAbstractSocket::UnconnectedState);
 }
-
-bool Connection::acceptsGzipEncoding(QString codings)
-{
-    // [rfc7231] 5.3.4. Accept-Encoding
-
-    const auto isCodingAvailable = [](const QVector<QStringRef> &list, const QString &encoding) -> bool
-    {
-        for (const QStringRef &str : list)
-        {
-            if (!str.startsWith(encoding))
-                continue;
-
-            // without quality values
-            if (str == encoding)
-                return true;
-
-            // [rfc7231] 5.3.1. Quality Values
-            const QStringRef substr = str.mid(encoding.size() + 3);  // ex. skip over "gzip;q="
-
-            bool ok = false;
-            const double qvalue = substr.toDouble(&ok);
-            if (!ok || (qvalue <= 0))
-                return false;
-
-            return true;
-        }
-        return false;
-    };
-
-    const QVector<QStringRef> list = codings.remove(' ').remove('\t').splitRef(',', Qt::SkipEmptyParts);
-    if (list.isEmpty())
-        return false;
-
-    const bool canGzip = isCodingAvailable(list, QLatin1String("gzip"));
-    if (canGzip)
-        return true;
-
-    const bool canAny = isCodingAvailable(list, QLatin1String("*"));
-    if (canAny)
-        return true;
-
-    return false;
-}
@@ -33,6 +33,8 @@
 #include <QElapsedTimer>
 #include <QObject>
 
+#include "requestparser.h"
+
 class QTcpSocket;
 
 namespace Http
@@ -56,12 +58,12 @@ namespace Http
         void read();
 
     private:
-        static bool acceptsGzipEncoding(QString codings);
         void sendResponse(const Response &response) const;
 
         QTcpSocket *m_socket;
         IRequestHandler *m_requestHandler;
         QByteArray m_receivedData;
+        RequestParser m_requestParser;
         QElapsedTimer m_idleTimer;
     };
 }
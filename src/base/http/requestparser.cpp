@@ -75,74 +75,90 @@ namespace
     }
 }
 
-RequestParser::RequestParser()
+RequestParser::ParseResult RequestParser::parse(const QByteArray &data)
 {
+    // Warning! Header names are converted to lowercase
+    const ParseResult result = doParse(data);
+    if (result.status != ParseStatus::Incomplete)
+        reset();
+    return result;
 }
 
-RequestParser::ParseResult RequestParser::parse(const QByteArray &data)
+void RequestParser::reset()
 {
-    // Warning! Header names are converted to lowercase
-    return RequestParser().doParse(data);
+    m_request = {};
+    m_headerSearchPos = 0;
+    m_headerLength = -1;
+    m_contentLength = 0;
 }
 
 RequestParser::ParseResult RequestParser::doParse(const QByteArray &data)
 {
-    // we don't handle malformed requests which use double `LF` as delimiter
-    const int headerEnd = data.indexOf(EOH);
-    if (headerEnd < 0)
-    {
-        qDebug() << Q_FUNC_INFO << "incomplete request";
-        return {ParseStatus::Incomplete, Request(), 0};
-    }
-
-    const QString httpHeaders = QString::fromLatin1(data.constData(), headerEnd);
-    if (!parseStartLines(httpHeaders))
+    if (m_headerLength < 0)
     {
-        qWarning() << Q_FUNC_INFO << "header parsing error";
-        return {ParseStatus::BadRequest, Request(), 0};
-    }
-
-    const int headerLength = headerEnd + EOH.length();
-
-    // handle supported methods
-    if ((m_request.method == HEADER_REQUEST_METHOD_GET) || (m_request.method == HEADER_REQUEST_METHOD_HEAD))
-        return {ParseStatus::OK, m_request, headerLength};
-    if (m_request.method == HEADER_REQUEST_METHOD_POST)
-    {
-        bool ok = false;
-        const int contentLength = m_request.headers[HEADER_CONTENT_LENGTH].toInt(&ok);
-        if (!ok || (contentLength < 0))
+        // we don't handle malformed requests which use double `LF` as delimiter
+        const int headerEnd = data.indexOf(EOH, m_headerSearchPos);
+        if (headerEnd < 0)
         {
-            qWarning() << Q_FUNC_INFO << "bad request: content-length invalid";
-            return {ParseStatus::BadRequest, Request(), 0};
+            // delimiter can be received partially so its possible beginning is scanned again
+            m_headerSearchPos = std::max(0, (data.size() - EOH.size() + 1));
+
+            qDebug() << Q_FUNC_INFO << "incomplete request";
+            return {ParseStatus::Incomplete, Request(), 0};
         }
-        if (contentLength > MAX_CONTENT_SIZE)
+
+        const QString httpHeaders = QString::fromLatin1(data.constData(), headerEnd);
+        if (!parseStartLines(httpHeaders))
         {
-            qWarning() << Q_FUNC_INFO << "bad request: message too long";
+            qWarning() << Q_FUNC_INFO << "header parsing error";
             return {ParseStatus::BadRequest, Request(), 0};
         }
 
-        if (contentLength > 0)
+        m_headerLength = headerEnd + EOH.length();
+
+        // handle supported methods
+        if (m_request.method == HEADER_REQUEST_METHOD_POST)
         {
-            const QByteArray httpBodyView = midView(data, headerLength, contentLength);
-            if (httpBodyView.length() < contentLength)
+            bool ok = false;
+            const int contentLength = m_request.headers[HEADER_CONTENT_LENGTH].toInt(&ok);
+            if (!ok || (contentLength < 0))
             {
-                qDebug() << Q_FUNC_INFO << "incomplete request";
-                return {ParseStatus::Incomplete, Request(), 0};
+                qWarning() << Q_FUNC_INFO << "bad request: content-length invalid";
+                return {ParseStatus::BadRequest, Request(), 0};
             }
-
-            if (!parsePostMessage(httpBodyView))
+            if (contentLength > MAX_CONTENT_SIZE)
             {
-                qWarning() << Q_FUNC_INFO << "message body parsing error";
+                qWarning() << Q_FUNC_INFO << "bad request: message too long";
                 return {ParseStatus::BadRequest, Request(), 0};
             }
+
+            m_contentLength = contentLength;
+        }
+        else if ((m_request.method != HEADER_REQUEST_METHOD_GET) && (m_request.method != HEADER_REQUEST_METHOD_HEAD))
+        {
+            qWarning() << Q_FUNC_INFO << "unsupported request method: " << m_request.method;
+            return {ParseStatus::BadRequest, Request(), 0};  // TODO: SHOULD respond "501 Not Implemented"
+        }
+    }
+
+    if (m_contentLength > 0)
+    {
+        // message body is parsed only once it is received completely
+        if ((data.size() - m_headerLength) < m_contentLength)
+        {
+            qDebug() << Q_FUNC_INFO << "incomplete request";
+            return {ParseStatus::Incomplete, Request(), 0};
         }
 
-        return {ParseStatus::OK, m_request, (headerLength + contentLength)};
+        const QByteArray httpBodyView = midView(data, m_headerLength, m_contentLength);
+        if (!parsePostMessage(httpBodyView))
+        {
+            qWarning() << Q_FUNC_INFO << "message body parsing error";
+            return {ParseStatus::BadRequest, Request(), 0};
+        }
     }
 
-    qWarning() << Q_FUNC_INFO << "unsupported request method: " << m_request.method;
-    return {ParseStatus::BadRequest, Request(), 0};  // TODO: SHOULD respond "501 Not Implemented"
+    return {ParseStatus::OK, m_request, (m_headerLength + m_contentLength)};
 }
 
 bool RequestParser::parseStartLines(const QString &data)
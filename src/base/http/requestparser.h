@@ -52,14 +52,16 @@ namespace Http
             long frameSize;  // http request frame size (bytes)
         };
 
-        static ParseResult parse(const QByteArray &data);
+        // `data` must start with the request being parsed. The parser keeps its progress
+        // between the calls until the request is parsed completely (or found to be bad),
+        // so the data that has been already scanned isn't processed again when more data is received.
+        ParseResult parse(const QByteArray &data);
 
         static const long MAX_CONTENT_SIZE = 64 * 1024 * 1024;  // 64 MB
 
     private:
-        RequestParser();
-
         ParseResult doParse(const QByteArray &data);
+        void reset();
         bool parseStartLines(const QString &data);
         bool parseRequestLine(const QString &line);
 
@@ -67,5 +69,8 @@ namespace Http
         bool parseFormData(const QByteArray &data);
 
         Request m_request;
+        int m_headerSearchPos = 0;
+        int m_headerLength = -1;  // -1 until the end of header is found
+        int m_contentLength = 0;
     };
 }
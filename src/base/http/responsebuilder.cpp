@@ -50,6 +50,11 @@ void ResponseBuilder::print(const QByteArray &data, const QString &type)
     print_impl(data, type);
 }
 
+void ResponseBuilder::setGzipContent(const QByteArray &data)
+{
+    m_response.gzipContent = data;
+}
+
 void ResponseBuilder::clear()
 {
     m_response = Response();
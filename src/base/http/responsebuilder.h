@@ -39,6 +39,7 @@ namespace Http
         void setHeader(const Header &header);
         void print(const QString &text, const QString &type = CONTENT_TYPE_HTML);
         void print(const QByteArray &data, const QString &type = CONTENT_TYPE_HTML);
+        void setGzipContent(const QByteArray &data);
         void clear();
 
         Response response() const;
@@ -30,6 +30,7 @@
 #include "responsegenerator.h"
 
 #include <QDateTime>
+#include <QVector>
 
 #include "base/http/types.h"
 #include "base/utils/gzip.h"
@@ -38,7 +39,9 @@ QByteArray Http::toByteArray(Response response)
 {
     compressContent(response);
 
-    response.headers[HEADER_CONTENT_LENGTH] = QString::number(response.content.length());
+    // "304 Not Modified" has no content, its Content-Length would describe the selected representation
+    if (response.status.code != 304)
+        response.headers[HEADER_CONTENT_LENGTH] = QString::number(response.content.length());
     response.headers[HEADER_DATE] = httpDate();
 
     QByteArray buf;
@@ -70,8 +73,20 @@ QString Http::httpDate()
     // [RFC 7231] 7.1.1.1. Date/Time Formats
     // example: "Sun, 06 Nov 1994 08:49:37 GMT"
 
-    return QLocale::c().toString(QDateTime::currentDateTimeUtc(), QLatin1String("ddd, dd MMM yyyy HH:mm:ss"))
-        .append(QLatin1String(" GMT"));
+    // the value changes once per second so there is no need to format it for every response
+    thread_local qint64 cachedTime = -1;
+    thread_local QString cachedDate;
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const qint64 time = now.toSecsSinceEpoch();
+    if (time != cachedTime)
+    {
+        cachedTime = time;
+        cachedDate = QLocale::c().toString(now, QLatin1String("ddd, dd MMM yyyy HH:mm:ss"))
+            .append(QLatin1String(" GMT"));
+    }
+
+    return cachedDate;
 }
 
 void Http::compressContent(Response &response)
@@ -81,26 +96,92 @@ void Http::compressContent(Response &response)
 
     response.headers.remove(HEADER_CONTENT_ENCODING);
 
+    if (response.gzipContent)
+    {
+        if (response.gzipContent->isEmpty())
+            return;
+
+        response.content = *response.gzipContent;
+        response.headers[HEADER_CONTENT_ENCODING] = QLatin1String("gzip");
+
+        // strong validator must differ for each content encoding
+        const auto etagIter = response.headers.find(HEADER_ETAG);
+        if ((etagIter != response.headers.end()) && etagIter->endsWith(QLatin1Char('"')))
+            etagIter->insert((etagIter->size() - 1), QLatin1String(GZIP_ETAG_SUFFIX));
+        return;
+    }
+
+    const QByteArray compressedData = compressContent(response.content, response.headers[HEADER_CONTENT_TYPE]);
+    if (compressedData.isEmpty())
+        return;
+
+    response.content = compressedData;
+    response.headers[HEADER_CONTENT_ENCODING] = QLatin1String("gzip");
+}
+
+bool Http::acceptsGzipEncoding(QString codings)
+{
+    // [rfc7231] 5.3.4. Accept-Encoding
+
+    const auto isCodingAvailable = [](const QVector<QStringRef> &list, const QString &encoding) -> bool
+    {
+        for (const QStringRef &str : list)
+        {
+            if (!str.startsWith(encoding))
+                continue;
+
+            // without quality values
+            if (str == encoding)
+                return true;
+
+            // [rfc7231] 5.3.1. Quality Values
+            const QStringRef substr = str.mid(encoding.size() + 3);  // ex. skip over "gzip;q="
+
+            bool ok = false;
+            const double qvalue = substr.toDouble(&ok);
+            if (!ok || (qvalue <= 0))
+                return false;
+
+            return true;
+        }
+        return false;
+    };
+
+    const QVector<QStringRef> list = codings.remove(' ').remove('\t').splitRef(',', Qt::SkipEmptyParts);
+    if (list.isEmpty())
+        return false;
+
+    const bool canGzip = isCodingAvailable(list, QLatin1String("gzip"));
+    if (canGzip)
+        return true;
+
+    const bool canAny = isCodingAvailable(list, QLatin1String("*"));
+    if (canAny)
+        return true;
+
+    return false;
+}
+
+QByteArray Http::compressContent(const QByteArray &content, const QString &contentType, const int level)
+{
     // for very small files, compressing them only wastes cpu cycles
-    const int contentSize = response.content.size();
+    const int contentSize = content.size();
     if (contentSize <= 1024)  // 1 kb
-        return;
+        return {};
 
     // filter out known hard-to-compress types
-    const QString contentType = response.headers[HEADER_CONTENT_TYPE];
     if ((contentType == CONTENT_TYPE_GIF) || (contentType == CONTENT_TYPE_PNG))
-        return;
+        return {};
 
     // try compressing
     bool ok = false;
-    const QByteArray compressedData = Utils::Gzip::compress(response.content, 6, &ok);
+    const QByteArray compressedData = Utils::Gzip::compress(content, level, &ok);
     if (!ok)
-        return;
+        return {};
 
     // "Content-Encoding: gzip\r\n" is 24 bytes long
     if ((compressedData.size() + 24) >= contentSize)
-        return;
+        return {};
 
-    response.content = compressedData;
-    response.headers[HEADER_CONTENT_ENCODING] = QLatin1String("gzip");
+    return compressedData;
 }
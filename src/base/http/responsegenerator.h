@@ -37,7 +37,13 @@ namespace Http
 {
     struct Response;
 
+    // Suffix of entity tag of gzip encoded content
+    inline const char GZIP_ETAG_SUFFIX[] = "-gzip";
+
     QByteArray toByteArray(Response response);
     QString httpDate();
+    bool acceptsGzipEncoding(QString codings);
     void compressContent(Response &response);
+    // Returns empty value if the content isn't worth compressing
+    QByteArray compressContent(const QByteArray &content, const QString &contentType, int level = 6);
 }
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <QHostAddress>
 #include <QString>
 #include <QVector>
@@ -38,6 +40,7 @@ namespace Http
     inline const char METHOD_GET[] = "GET";
     inline const char METHOD_POST[] = "POST";
 
+    inline const char HEADER_ACCEPT_ENCODING[] = "accept-encoding";
     inline const char HEADER_CACHE_CONTROL[] = "cache-control";
     inline const char HEADER_CONNECTION[] = "connection";
     inline const char HEADER_CONTENT_DISPOSITION[] = "content-disposition";
@@ -46,7 +49,9 @@ namespace Http
     inline const char HEADER_CONTENT_SECURITY_POLICY[] = "content-security-policy";
     inline const char HEADER_CONTENT_TYPE[] = "content-type";
     inline const char HEADER_DATE[] = "date";
+    inline const char HEADER_ETAG[] = "etag";
     inline const char HEADER_HOST[] = "host";
+    inline const char HEADER_IF_NONE_MATCH[] = "if-none-match";
     inline const char HEADER_ORIGIN[] = "origin";
     inline const char HEADER_REFERER[] = "referer";
     inline const char HEADER_REFERRER_POLICY[] = "referrer-policy";
@@ -120,6 +125,9 @@ namespace Http
         ResponseStatus status;
         HeaderMap headers;
         QByteArray content;
+        // gzip compressed content prepared in advance, so it isn't compressed on every response.
+        // Empty value means the content isn't worth compressing.
+        std::optional<QByteArray> gzipContent;
 
         Response(uint code = 200, const QString &text = QLatin1String("OK"))
             : status {code, text}
@@ -122,6 +122,17 @@ void DownloadHandlerImpl::processFinishedDownload()
         return;
     }
 
+    m_result.eTag = QString::fromLatin1(m_reply->rawHeader("ETag"));
+    m_result.lastModified = QString::fromLatin1(m_reply->rawHeader("Last-Modified"));
+
+    // The content matching the validators sent with the request is unchanged
+    if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304)
+    {
+        m_result.status = Net::DownloadStatus::NotModified;
+        finish();
+        return;
+    }
+
     // Success
     m_result.data = (m_reply->rawHeader("Content-Encoding") == "gzip")
                     ? Utils::Gzip::decompress(m_reply->readAll())
@@ -125,6 +125,11 @@ namespace
         request.setRawHeader("Referer", request.url().toEncoded().data());
         // Accept gzip
         request.setRawHeader("Accept-Encoding", "gzip");
+        // Conditional request
+        if (!downloadRequest.eTag().isEmpty())
+            request.setRawHeader("If-None-Match", downloadRequest.eTag().toLatin1());
+        if (!downloadRequest.lastModified().isEmpty())
+            request.setRawHeader("If-Modified-Since", downloadRequest.lastModified().toLatin1());
         // Qt doesn't support Magnet protocol so we need to handle redirections manually
         request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
 
@@ -348,6 +353,28 @@ Net::DownloadRequest &Net::DownloadRequest::saveToFile(const bool value)
     return *this;
 }
 
+QString Net::DownloadRequest::eTag() const
+{
+    return m_eTag;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::eTag(const QString &value)
+{
+    m_eTag = value;
+    return *this;
+}
+
+QString Net::DownloadRequest::lastModified() const
+{
+    return m_lastModified;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::lastModified(const QString &value)
+{
+    m_lastModified = value;
+    return *this;
+}
+
 Net::ServiceID Net::ServiceID::fromURL(const QUrl &url)
 {
     return {url.host(), url.port(80)};
@@ -57,6 +57,7 @@ namespace Net
     {
         Success,
         RedirectedToMagnet,
+        NotModified,
         Failed
     };
 
@@ -78,11 +79,21 @@ namespace Net
         bool saveToFile() const;
         DownloadRequest &saveToFile(bool value);
 
+        // Validators of the previously downloaded content.
+        // If any is set the server may reply with "304 Not Modified".
+        QString eTag() const;
+        DownloadRequest &eTag(const QString &value);
+
+        QString lastModified() const;
+        DownloadRequest &lastModified(const QString &value);
+
     private:
         QString m_url;
         QString m_userAgent;
         qint64 m_limit = 0;
         bool m_saveToFile = false;
+        QString m_eTag;
+        QString m_lastModified;
     };
 
     struct DownloadResult
@@ -93,6 +104,8 @@ namespace Net
         QByteArray data;
         QString filePath;
         QString magnet;
+        QString eTag;
+        QString lastModified;
     };
 
     class DownloadHandler : public QObject
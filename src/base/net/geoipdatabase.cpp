@@ -26,6 +26,9 @@
  * exception statement from your version.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
@@ -40,6 +43,8 @@ namespace
     const quint32 MAX_METADATA_SIZE = 131072; // 128KB
     const char METADATA_BEGIN_MARK[] = "\xab\xcd\xefMaxMind.com";
     const char DATA_SECTION_SEPARATOR[16] = {0};
+    // IPv4 addresses are looked up as IPv4-mapped IPv6 addresses (::ffff:0:0/96)
+    const int IPV4_MAPPED_PREFIX_LENGTH = 96;
 
     enum class DataType
     {
@@ -72,41 +77,53 @@ struct DataFieldDescriptor
     };
 };
 
-GeoIPDatabase::GeoIPDatabase(const quint32 size)
+GeoIPDatabase::GeoIPDatabase()
     : m_ipVersion(0)
     , m_recordSize(0)
     , m_nodeCount(0)
     , m_nodeSize(0)
     , m_indexSize(0)
     , m_recordBytes(0)
-    , m_size(size)
-    , m_data(new uchar[size])
+    , m_size(0)
+    , m_data(nullptr)
 {
 }
 
 GeoIPDatabase *GeoIPDatabase::load(const QString &filename, QString &error)
 {
-    GeoIPDatabase *db = nullptr;
-    QFile file(filename);
+    auto *db = new GeoIPDatabase;
+    QFile &file = db->m_file;
+    file.setFileName(filename);
     if (file.size() > MAX_FILE_SIZE)
     {
         error = tr("Unsupported database file size.");
+        delete db;
         return nullptr;
     }
 
     if (!file.open(QFile::ReadOnly))
     {
         error = file.errorString();
+        delete db;
         return nullptr;
     }
 
-    db = new GeoIPDatabase(file.size());
-
-    if (file.read(reinterpret_cast<char *>(db->m_data), db->m_size) != db->m_size)
+    db->m_size = file.size();
+    // Map the file read-only instead of copying it to the heap.
+    // The mapping stays valid until the database (and its QFile) is destroyed.
+    db->m_data = file.map(0, db->m_size);
+    if (!db->m_data)
     {
-        error = file.errorString();
-        delete db;
-        return nullptr;
+        db->m_buffer = file.readAll();
+        if (db->m_buffer.size() != static_cast<int>(db->m_size))
+        {
+            error = file.errorString();
+            delete db;
+            return nullptr;
+        }
+
+        db->m_data = reinterpret_cast<const uchar *>(db->m_buffer.constData());
+        file.close();
     }
 
 
@@ -116,21 +133,23 @@ GeoIPDatabase *GeoIPDatabase::load(const QString &filename, QString &error)
         return nullptr;
     }
 
+    db->buildLookupTables();
     return db;
 }
 
 GeoIPDatabase *GeoIPDatabase::load(const QByteArray &data, QString &error)
 {
-    GeoIPDatabase *db = nullptr;
     if (data.size() > MAX_FILE_SIZE)
     {
         error = tr("Unsupported database file size.");
         return nullptr;
     }
 
-    db = new GeoIPDatabase(data.size());
-
-    memcpy(reinterpret_cast<char *>(db->m_data), data.constData(), db->m_size);
+    auto *db = new GeoIPDatabase;
+    // Share the buffer instead of copying it
+    db->m_buffer = data;
+    db->m_size = data.size();
+    db->m_data = reinterpret_cast<const uchar *>(db->m_buffer.constData());
 
     if (!db->parseMetadata(db->readMetadata(), error) || !db->loadDB(error))
     {
@@ -138,13 +157,11 @@ GeoIPDatabase *GeoIPDatabase::load(const QByteArray &data, QString &error)
         return nullptr;
     }
 
+    db->buildLookupTables();
     return db;
 }
 
-GeoIPDatabase::~GeoIPDatabase()
-{
-    delete [] m_data;
-}
+GeoIPDatabase::~GeoIPDatabase() = default;
 
 QString GeoIPDatabase::type() const
 {
@@ -163,47 +180,31 @@ QDateTime GeoIPDatabase::buildEpoch() const
 
 QString GeoIPDatabase::lookup(const QHostAddress &hostAddr) const
 {
-    Q_IPV6ADDR addr = hostAddr.toIPv6Address();
+    bool isIPv4 = false;
+    const quint32 ipv4 = hostAddr.toIPv4Address(&isIPv4);
+    if (isIPv4)
+    {
+        const auto iter = std::upper_bound(m_ipv4RangeStarts.cbegin(), m_ipv4RangeStarts.cend(), ipv4);
+        if (iter == m_ipv4RangeStarts.cbegin())
+            return {};
+
+        const int rangeIndex = static_cast<int>(std::distance(m_ipv4RangeStarts.cbegin(), iter)) - 1;
+        return m_countryCodes[m_ipv4RangeCountries[rangeIndex]];
+    }
 
-    const uchar *ptr = m_data;
+    const Q_IPV6ADDR addr = hostAddr.toIPv6Address();
 
-    for (int i = 0; i < 16; ++i)
+    quint32 nodeId = 0;
+    for (int i = 0; i < 128; ++i)
     {
-        for (int j = 0; j < 8; ++j)
-        {
-            const bool right = static_cast<bool>((addr[i] >> (7 - j)) & 1);
-            // Interpret the left/right record as number
-            if (right)
-                ptr += m_recordBytes;
-
-            quint32 id = 0;
-            auto *idPtr = reinterpret_cast<uchar *>(&id);
-            memcpy(&idPtr[4 - m_recordBytes], ptr, m_recordBytes);
-            fromBigEndian(idPtr, 4);
-
-            if (id == m_nodeCount)
-            {
-                return {};
-            }
-            if (id > m_nodeCount)
-            {
-                QString country = m_countries.value(id);
-                if (country.isEmpty())
-                {
-                    const quint32 offset = id - m_nodeCount - sizeof(DATA_SECTION_SEPARATOR);
-                    quint32 tmp = offset + m_indexSize + sizeof(DATA_SECTION_SEPARATOR);
-                    const QVariant val = readDataField(tmp);
-                    if (val.userType() == QMetaType::QVariantHash)
-                    {
-                        country = val.toHash()["country"].toHash()["iso_code"].toString();
-                        m_countries[id] = country;
-                    }
-                }
-                return country;
-            }
-
-            ptr = m_data + (id * m_nodeSize);
-        }
+        const bool right = static_cast<bool>((addr[i / 8] >> (7 - (i % 8))) & 1);
+        const quint32 id = readRecord(nodeId, right);
+        if (id == m_nodeCount)
+            return {};
+        if (id > m_nodeCount)
+            return m_countryCodes[m_recordCountries.value(id)];
+
+        nodeId = id;
     }
 
     return {};
@@ -298,6 +299,93 @@ bool GeoIPDatabase::loadDB(QString &error) const
     return true;
 }
 
+void GeoIPDatabase::buildLookupTables()
+{
+    qDebug() << "Building IP geolocation lookup tables...";
+
+    m_countryCodes = {QString()};
+    m_recordCountries.clear();
+    m_ipv4RangeStarts.clear();
+    m_ipv4RangeCountries.clear();
+
+    // Decode the country of every data record referenced by the tree
+    for (quint32 nodeId = 0; nodeId < m_nodeCount; ++nodeId)
+    {
+        countryIndex(readRecord(nodeId, false));
+        countryIndex(readRecord(nodeId, true));
+    }
+
+    // Find the subtree of IPv4-mapped addresses
+    quint32 ipv4Root = 0;
+    for (int i = 0; (i < IPV4_MAPPED_PREFIX_LENGTH) && (ipv4Root < m_nodeCount); ++i)
+        ipv4Root = readRecord(ipv4Root, (i >= 80));
+
+    const auto appendRange = [this](const quint32 start, const quint16 country)
+    {
+        if (!m_ipv4RangeCountries.isEmpty() && (m_ipv4RangeCountries.last() == country))
+            return;
+
+        m_ipv4RangeStarts.append(start);
+        m_ipv4RangeCountries.append(country);
+    };
+
+    // Depth-first walk, left branches first, so ranges come out sorted
+    struct Record
+    {
+        quint32 id;
+        quint32 prefix;
+        int depth;
+    };
+    std::vector<Record> stack {{ipv4Root, 0, 0}};
+    while (!stack.empty())
+    {
+        const Record record = stack.back();
+        stack.pop_back();
+
+        if ((record.id >= m_nodeCount) || (record.depth == 32))
+        {
+            appendRange(record.prefix, countryIndex(record.id));
+            continue;
+        }
+
+        stack.push_back({readRecord(record.id, true), (record.prefix | (1u << (31 - record.depth))), (record.depth + 1)});
+        stack.push_back({readRecord(record.id, false), record.prefix, (record.depth + 1)});
+    }
+}
+
+quint32 GeoIPDatabase::readRecord(const quint32 nodeId, const bool right) const
+{
+    // Records are 24 bits wide (see parseMetadata())
+    const uchar *ptr = m_data + (nodeId * m_nodeSize) + (right ? m_recordBytes : 0);
+    return (static_cast<quint32>(ptr[0]) << 16) | (static_cast<quint32>(ptr[1]) << 8) | ptr[2];
+}
+
+quint16 GeoIPDatabase::countryIndex(const quint32 recordId)
+{
+    if (recordId <= m_nodeCount)
+        return 0;
+
+    const auto iter = m_recordCountries.constFind(recordId);
+    if (iter != m_recordCountries.cend())
+        return iter.value();
+
+    QString country;
+    quint32 offset = recordId - m_nodeCount + m_indexSize;
+    const QVariant val = readDataField(offset);
+    if (val.userType() == QMetaType::QVariantHash)
+        country = val.toHash()["country"].toHash()["iso_code"].toString();
+
+    int index = m_countryCodes.indexOf(country);
+    if (index < 0)
+    {
+        index = m_countryCodes.size();
+        m_countryCodes.append(country);
+    }
+
+    m_recordCountries.insert(recordId, static_cast<quint16>(index));
+    return static_cast<quint16>(index);
+}
+
 QVariantHash GeoIPDatabase::readMetadata() const
 {
     const char *ptr = reinterpret_cast<const char *>(m_data);
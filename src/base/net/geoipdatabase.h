@@ -28,10 +28,13 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QVector>
 #include <QtGlobal>
 
-class QByteArray;
 class QDateTime;
 class QHostAddress;
 class QString;
@@ -54,12 +57,16 @@ public:
     QString lookup(const QHostAddress &hostAddr) const;
 
 private:
-    explicit GeoIPDatabase(quint32 size);
+    GeoIPDatabase();
 
     bool parseMetadata(const QVariantHash &metadata, QString &error);
     bool loadDB(QString &error) const;
+    void buildLookupTables();
     QVariantHash readMetadata() const;
 
+    quint32 readRecord(quint32 nodeId, bool right) const;
+    quint16 countryIndex(quint32 recordId);
+
     QVariant readDataField(quint32 &offset) const;
     bool readDataFieldDescriptor(quint32 &offset, DataFieldDescriptor &out) const;
     void fromBigEndian(uchar *buf, quint32 len) const;
@@ -95,7 +102,16 @@ private:
     QDateTime m_buildEpoch;
     QString m_dbType;
     // Search data
-    mutable QHash<quint32, QString> m_countries;
+    // Country codes decoded at load time, index 0 means "no data"
+    QVector<QString> m_countryCodes;
+    // data record ID -> index in m_countryCodes
+    QHash<quint32, quint16> m_recordCountries;
+    // IPv4 part of the search tree flattened to sorted ranges
+    QVector<quint32> m_ipv4RangeStarts;
+    QVector<quint16> m_ipv4RangeCountries;
+    // The database is either mapped from m_file or kept in m_buffer
+    QFile m_file;
+    QByteArray m_buffer;
     quint32 m_size;
-    uchar *m_data;
+    const uchar *m_data;
 };
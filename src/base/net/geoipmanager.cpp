@@ -31,9 +31,9 @@
 
 #include <QDateTime>
 #include <QDir>
-#include <QFile>
 #include <QHostAddress>
 #include <QLocale>
+#include <QSaveFile>
 
 #include "base/logger.h"
 #include "base/preferences.h"
@@ -442,6 +442,8 @@ void GeoIPManager::downloadFinished(const DownloadResult &result)
     {
         if (!m_geoIPDatabase || (geoIPDatabase->buildEpoch() > m_geoIPDatabase->buildEpoch()))
         {
+            // The old database may be mapped from the file being replaced,
+            // so release it before the file is written
             delete m_geoIPDatabase;
             m_geoIPDatabase = geoIPDatabase;
             LogMsg(tr("IP geolocation database loaded. Type: %1. Build time: %2.")
@@ -451,11 +453,24 @@ void GeoIPManager::downloadFinished(const DownloadResult &result)
                         specialFolderLocation(SpecialFolder::Data) + GEODB_FOLDER);
             if (!QDir(targetPath).exists())
                 QDir().mkpath(targetPath);
-            QFile targetFile(QString::fromLatin1("%1/%2").arg(targetPath, GEODB_FILENAME));
-            if (!targetFile.open(QFile::WriteOnly) || (targetFile.write(data) == -1))
+            const QString targetFilePath = QString::fromLatin1("%1/%2").arg(targetPath, GEODB_FILENAME);
+            QSaveFile targetFile(targetFilePath);
+            if (!targetFile.open(QIODevice::WriteOnly) || (targetFile.write(data) != data.size()) || !targetFile.commit())
+            {
                 LogMsg(tr("Couldn't save downloaded IP geolocation database file."), Log::WARNING);
+            }
             else
+            {
                 LogMsg(tr("Successfully updated IP geolocation database."), Log::INFO);
+
+                // Switch to the mapped file so the downloaded copy can be freed
+                QString mapError;
+                if (GeoIPDatabase *mappedDatabase = GeoIPDatabase::load(targetFilePath, mapError))
+                {
+                    delete m_geoIPDatabase;
+                    m_geoIPDatabase = mappedDatabase;
+                }
+            }
         }
         else
         {
@@ -31,8 +31,10 @@
 #include "rss_feed.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
+#include <QCryptographicHash>
 #include <QDir>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -58,6 +60,13 @@ const QString KEY_ISLOADING(QStringLiteral("isLoading"));
 const QString KEY_HASERROR(QStringLiteral("hasError"));
 const QString KEY_ARTICLES(QStringLiteral("articles"));
 
+const QString KEY_JOURNAL_ARTICLE(QStringLiteral("article"));
+const QString KEY_JOURNAL_READ(QStringLiteral("read"));
+const QString KEY_JOURNAL_READALL(QStringLiteral("readAll"));
+
+// The journal is merged into the articles file when it gets larger than the articles file itself
+const int MIN_JOURNAL_ENTRIES_TO_COMPACT = 100;
+
 using namespace RSS;
 
 Feed::Feed(const QUuid &uid, const QString &url, const QString &path, Session *session)
@@ -67,6 +76,7 @@ Feed::Feed(const QUuid &uid, const QString &url, const QString &path, Session *s
     , m_url(url)
 {
     m_dataFileName = QString::fromLatin1(m_uid.toRfc4122().toHex()) + QLatin1String(".json");
+    m_journalFileName = QString::fromLatin1(m_uid.toRfc4122().toHex()) + QLatin1String(".journal");
 
     // Move to new file naming scheme (since v4.1.2)
     const QString legacyFilename
@@ -120,7 +130,7 @@ void Feed::markAsRead()
 
     if (m_unreadCount != oldUnreadCount)
     {
-        m_dirty = true;
+        appendToJournal({{KEY_JOURNAL_READALL, true}});
         store();
         emit unreadCountChanged(this);
     }
@@ -133,7 +143,8 @@ void Feed::refresh()
 
     // NOTE: Should we allow manually refreshing for disabled session?
 
-    m_downloadHandler = Net::DownloadManager::instance()->download(m_url);
+    m_downloadHandler = Net::DownloadManager::instance()->download(
+            Net::DownloadRequest(m_url).eTag(m_eTag).lastModified(m_lastModified));
     connect(m_downloadHandler, &Net::DownloadHandler::finished, this, &Feed::handleDownloadFinished);
 
     m_isLoading = true;
@@ -200,23 +211,48 @@ void Feed::handleDownloadFinished(const Net::DownloadResult &result)
 {
     m_downloadHandler = nullptr; // will be deleted by DownloadManager later
 
-    if (result.status == Net::DownloadStatus::Success)
-    {
-        LogMsg(tr("RSS feed at '%1' is successfully downloaded. Starting to parse it.")
-                .arg(result.url));
-        // Parse the download RSS
-        m_parser->parse(result.data);
-    }
-    else
+    if ((result.status != Net::DownloadStatus::Success) && (result.status != Net::DownloadStatus::NotModified))
     {
         m_isLoading = false;
         m_hasError = true;
+        // Make sure the feed is parsed again on the next refresh to update its state
+        m_eTag.clear();
+        m_lastModified.clear();
+        m_dataHash.clear();
 
         LogMsg(tr("Failed to download RSS feed at '%1'. Reason: %2")
                .arg(result.url, result.errorString), Log::WARNING);
 
         emit stateChanged(this);
+        return;
+    }
+
+    // Servers may omit the validators in "304 Not Modified" reply
+    if (!result.eTag.isEmpty() || !result.lastModified.isEmpty())
+    {
+        m_eTag = result.eTag;
+        m_lastModified = result.lastModified;
+    }
+
+    // Some servers don't support validators so the content is also compared by its hash
+    const QByteArray dataHash = (result.status == Net::DownloadStatus::Success)
+        ? QCryptographicHash::hash(result.data, QCryptographicHash::Sha1)
+        : m_dataHash;
+    if (dataHash == m_dataHash)
+    {
+        LogMsg(tr("RSS feed at '%1' is not changed since the last update.").arg(result.url));
+
+        m_isLoading = false;
+        emit stateChanged(this);
+        return;
     }
+
+    m_dataHash = dataHash;
+
+    LogMsg(tr("RSS feed at '%1' is successfully downloaded. Starting to parse it.")
+            .arg(result.url));
+    // Parse the download RSS
+    m_parser->parse(result.data);
 }
 
 void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
@@ -226,22 +262,19 @@ void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
     if (!result.title.isEmpty() && (title() != result.title))
     {
         m_title = result.title;
-        m_dirty = true;
         emit titleChanged(this);
     }
 
     if (!result.lastBuildDate.isEmpty())
-    {
         m_lastBuildDate = result.lastBuildDate;
-        m_dirty = true;
-    }
 
     // For some reason, the RSS feed may contain malformed XML data and it may not be
     // successfully parsed by the XML parser. We are still trying to load as many articles
     // as possible until we encounter corrupted data. So we can have some articles here
     // even in case of parsing error.
     const int newArticlesCount = updateArticles(result.articles);
-    store();
+    if (newArticlesCount > 0)
+        store();
 
     if (m_hasError)
     {
@@ -257,13 +290,13 @@ void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
 
 void Feed::load()
 {
-    QFile file(m_session->dataFileStorage()->storageDir().absoluteFilePath(m_dataFileName));
+    const QDir storageDir {m_session->dataFileStorage()->storageDir()};
+    QFile file(storageDir.absoluteFilePath(m_dataFileName));
 
     if (!file.exists())
     {
         loadArticlesLegacy();
-        m_dirty = true;
-        store(); // convert to new format
+        m_dirty = true; // convert to new format
     }
     else if (file.open(QFile::ReadOnly))
     {
@@ -276,6 +309,25 @@ void Feed::load()
                .arg(m_dataFileName, file.errorString())
                , Log::WARNING);
     }
+
+    QFile journalFile(storageDir.absoluteFilePath(m_journalFileName));
+    if (journalFile.exists())
+    {
+        if (journalFile.open(QFile::ReadOnly))
+        {
+            loadJournal(journalFile.readAll());
+            journalFile.close();
+        }
+        else
+        {
+            LogMsg(tr("Couldn't read RSS Session data from %1. Error: %2")
+                   .arg(m_journalFileName, journalFile.errorString())
+                   , Log::WARNING);
+        }
+    }
+
+    // Compact the journal if it is too large already
+    store();
 }
 
 void Feed::loadArticles(const QByteArray &data)
@@ -339,18 +391,104 @@ void Feed::loadArticlesLegacy()
     }
 }
 
+void Feed::loadJournal(const QByteArray &data)
+{
+    // Journal contains one JSON object per line. Its entries are applied on top of the articles file
+    // and may be already merged into it if the application was closed in the middle of compaction.
+    int from = 0;
+    while (from < data.size())
+    {
+        int to = data.indexOf('\n', from);
+        if (to < 0)
+            to = data.size();
+
+        const QByteArray line = data.mid(from, (to - from));
+        from = to + 1;
+        if (line.trimmed().isEmpty())
+            continue;
+
+        ++m_journalEntryCount;
+
+        const QJsonDocument jsonDoc = QJsonDocument::fromJson(line);
+        if (!jsonDoc.isObject())
+        {
+            // Probably the last entry was written partially. Rewrite the articles file to get rid of it.
+            LogMsg(tr("Couldn't load RSS article '%1#%2'. Invalid data format.").arg(m_url).arg(m_journalEntryCount - 1)
+                   , Log::WARNING);
+            m_dirty = true;
+            continue;
+        }
+
+        const QJsonObject jsonObj = jsonDoc.object();
+        if (jsonObj.contains(KEY_JOURNAL_ARTICLE))
+        {
+            const QJsonObject articleObj = jsonObj.value(KEY_JOURNAL_ARTICLE).toObject();
+            if (m_articles.contains(articleObj.value(Article::KeyId).toString()))
+                continue;
+
+            try
+            {
+                auto article = new Article(this, articleObj);
+                if (!addArticle(article))
+                    delete article;
+            }
+            catch (const RuntimeError &) {}
+        }
+        else if (jsonObj.contains(KEY_JOURNAL_READ))
+        {
+            Article *article = articleByGUID(jsonObj.value(KEY_JOURNAL_READ).toString());
+            if (article && !article->isRead())
+            {
+                article->disconnect(this);
+                article->markAsRead();
+                decreaseUnreadCount();
+            }
+        }
+        else if (jsonObj.value(KEY_JOURNAL_READALL).toBool())
+        {
+            for (Article *article : asConst(m_articles))
+            {
+                if (!article->isRead())
+                {
+                    article->disconnect(this);
+                    article->markAsRead();
+                    decreaseUnreadCount();
+                }
+            }
+        }
+    }
+}
+
+void Feed::appendToJournal(const QJsonObject &entry)
+{
+    m_journal.append(QJsonDocument(entry).toJson(QJsonDocument::Compact));
+    m_journal.append('\n');
+    ++m_journalEntryCount;
+}
+
 void Feed::store()
 {
-    if (!m_dirty) return;
+    m_savingTimer.stop();
+
+    if (!m_dirty && (m_journalEntryCount < std::max(MIN_JOURNAL_ENTRIES_TO_COMPACT, m_articles.size())))
+    {
+        if (!m_journal.isEmpty())
+            m_session->dataFileStorage()->append(m_journalFileName, std::exchange(m_journal, {}));
+        return;
+    }
 
+    // Compact journal into the articles file
     m_dirty = false;
-    m_savingTimer.stop();
+    m_journal.clear();
+    m_journalEntryCount = 0;
 
     QJsonArray jsonArr;
     for (Article *article :asConst(m_articles))
         jsonArr << article->toJsonObject();
 
+    // Both requests are processed sequentially so the journal is truncated only after the articles file is saved
     m_session->dataFileStorage()->store(m_dataFileName, QJsonDocument(jsonArr).toJson());
+    m_session->dataFileStorage()->store(m_journalFileName, {});
 }
 
 void Feed::storeDeferred()
@@ -379,7 +517,6 @@ bool Feed::addArticle(Article *article)
         connect(article, &Article::read, this, &Feed::handleArticleRead);
     }
 
-    m_dirty = true;
     emit newArticle(article);
 
     if (m_articlesByDate.size() > maxArticles)
@@ -487,7 +624,9 @@ int Feed::updateArticles(const QList<QVariantHash> &loadedArticles)
     {
         if (a.second)
         {
-            addArticle(new Article {this, *a.second});
+            auto article = new Article {this, *a.second};
+            appendToJournal({{KEY_JOURNAL_ARTICLE, article->toJsonObject()}});
+            addArticle(article);
             ++newArticlesCount;
         }
     });
@@ -538,13 +677,15 @@ void Feed::handleArticleRead(Article *article)
     decreaseUnreadCount();
     emit articleRead(article);
     // will be stored deferred
-    m_dirty = true;
+    appendToJournal({{KEY_JOURNAL_READ, article->guid()}});
     storeDeferred();
 }
 
 void Feed::cleanup()
 {
-    Utils::Fs::forceRemove(m_session->dataFileStorage()->storageDir().absoluteFilePath(m_dataFileName));
+    const QDir storageDir {m_session->dataFileStorage()->storageDir()};
+    Utils::Fs::forceRemove(storageDir.absoluteFilePath(m_dataFileName));
+    Utils::Fs::forceRemove(storageDir.absoluteFilePath(m_journalFileName));
 }
 
 void Feed::timerEvent(QTimerEvent *event)
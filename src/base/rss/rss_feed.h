@@ -38,6 +38,7 @@
 #include "rss_item.h"
 
 class AsyncFileStorage;
+class QJsonObject;
 
 namespace Net
 {
@@ -102,6 +103,8 @@ namespace RSS
         void load();
         void loadArticles(const QByteArray &data);
         void loadArticlesLegacy();
+        void loadJournal(const QByteArray &data);
+        void appendToJournal(const QJsonObject &entry);
         void store();
         void storeDeferred();
         bool addArticle(Article *article);
@@ -124,6 +127,14 @@ namespace RSS
         int m_unreadCount = 0;
         QString m_iconPath;
         QString m_dataFileName;
+        // Changes made since the last snapshot are appended to the journal file
+        QString m_journalFileName;
+        QByteArray m_journal;
+        int m_journalEntryCount = 0;
+        // Used to avoid parsing the feed again if it isn't changed
+        QString m_eTag;
+        QString m_lastModified;
+        QByteArray m_dataHash;
         QBasicTimer m_savingTimer;
         bool m_dirty = false;
         Net::DownloadHandler *m_downloadHandler = nullptr;
@@ -29,11 +29,12 @@
 
 #include "searchhandler.h"
 
+#include <charconv>
+#include <cstring>
+
 #include <QProcess>
 #include <QTimer>
-#include <QVector>
 
-#include "base/global.h"
 #include "base/utils/foreignapps.h"
 #include "base/utils/fs.h"
 #include "searchpluginmanager.h"
@@ -51,6 +52,42 @@ namespace
         PL_DESC_LINK,
         NB_PLUGIN_COLUMNS
     };
+
+    // Part of the raw process output, so that lines can be parsed without copying them
+    struct ByteRange
+    {
+        const char *begin;
+        const char *end;
+    };
+
+    bool isSpace(const char c)
+    {
+        return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '\v') || (c == '\f'));
+    }
+
+    ByteRange trimmed(ByteRange range)
+    {
+        while ((range.begin != range.end) && isSpace(*range.begin))
+            ++range.begin;
+        while ((range.end != range.begin) && isSpace(*(range.end - 1)))
+            --range.end;
+        return range;
+    }
+
+    QString toString(const ByteRange range)
+    {
+        const ByteRange str = trimmed(range);
+        return QString::fromUtf8(str.begin, (str.end - str.begin));
+    }
+
+    qlonglong toLongLong(const ByteRange range, bool *ok)
+    {
+        const ByteRange str = trimmed(range);
+        qlonglong value = 0;
+        const auto [ptr, ec] = std::from_chars(str.begin, str.end, value);
+        *ok = ((ec == std::errc()) && (ptr == str.end));
+        return *ok ? value : 0;
+    }
 }
 
 SearchHandler::SearchHandler(const QString &pattern, const QString &category, const QStringList &usedPlugins, SearchPluginManager *manager)
@@ -128,30 +165,25 @@ void SearchHandler::processFinished(const int exitcode)
 // line to SearchResult calling parseSearchResult().
 void SearchHandler::readSearchOutput()
 {
-    QByteArray output = m_searchProcess->readAllStandardOutput();
-    output.replace('\r', "");
-
-    QList<QByteArray> lines = output.split('\n');
-    if (!m_searchResultLineTruncated.isEmpty())
-        lines.prepend(m_searchResultLineTruncated + lines.takeFirst());
-    m_searchResultLineTruncated = lines.takeLast().trimmed();
-
-    QVector<SearchResult> searchResultList;
-    searchResultList.reserve(lines.size());
+    m_searchOutput.append(m_searchProcess->readAllStandardOutput());
 
-    for (const QByteArray &line : asConst(lines))
+    const int first = m_results.size();
+    const char *const outputBegin = m_searchOutput.constData();
+    const char *const outputEnd = outputBegin + m_searchOutput.size();
+    const char *lineBegin = outputBegin;
+    while (const auto *lineEnd = static_cast<const char *>(std::memchr(lineBegin, '\n', (outputEnd - lineBegin))))
     {
         SearchResult searchResult;
-        if (parseSearchResult(QString::fromUtf8(line), searchResult))
-            searchResultList << searchResult;
+        if (parseSearchResult(lineBegin, lineEnd, searchResult))
+            m_results.append(searchResult);
+        lineBegin = lineEnd + 1;
     }
+    // keep the truncated line until the rest of it is received
+    m_searchOutput.remove(0, (lineBegin - outputBegin));
 
-    if (!searchResultList.isEmpty())
-    {
-        for (const SearchResult &result : searchResultList)
-            m_results.append(result);
-        emit newSearchResults(searchResultList);
-    }
+    const int last = m_results.size() - 1;
+    if (last >= first)
+        emit newSearchResults(first, last);
 }
 
 void SearchHandler::processFailed()
@@ -163,31 +195,44 @@ void SearchHandler::processFailed()
 // Parse one line of search results list
 // Line is in the following form:
 // file url | file name | file size | nb seeds | nb leechers | Search engine url
-bool SearchHandler::parseSearchResult(const QString &line, SearchResult &searchResult)
+bool SearchHandler::parseSearchResult(const char *begin, const char *end, SearchResult &searchResult) const
 {
-    const QVector<QStringRef> parts = line.splitRef('|');
-    const int nbFields = parts.size();
+    ByteRange parts[NB_PLUGIN_COLUMNS];
+    int nbFields = 0;
+    for (const char *partBegin = begin; ; ++nbFields)
+    {
+        const auto *partEnd = static_cast<const char *>(std::memchr(partBegin, '|', (end - partBegin)));
+        if (nbFields < NB_PLUGIN_COLUMNS)
+            parts[nbFields] = {partBegin, (partEnd ? partEnd : end)};
+        if (!partEnd)
+        {
+            ++nbFields;
+            break;
+        }
+        partBegin = partEnd + 1;
+    }
 
     if (nbFields < (NB_PLUGIN_COLUMNS - 1)) return false; // -1 because desc_link is optional
 
     searchResult = SearchResult();
-    searchResult.fileUrl = parts.at(PL_DL_LINK).trimmed().toString(); // download URL
-    searchResult.fileName = parts.at(PL_NAME).trimmed().toString(); // Name
-    searchResult.fileSize = parts.at(PL_SIZE).trimmed().toLongLong(); // Size
+    searchResult.fileUrl = toString(parts[PL_DL_LINK]); // download URL
+    searchResult.fileName = toString(parts[PL_NAME]); // Name
 
     bool ok = false;
 
-    searchResult.nbSeeders = parts.at(PL_SEEDS).trimmed().toLongLong(&ok); // Seeders
+    searchResult.fileSize = toLongLong(parts[PL_SIZE], &ok); // Size
+
+    searchResult.nbSeeders = toLongLong(parts[PL_SEEDS], &ok); // Seeders
     if (!ok || (searchResult.nbSeeders < 0))
         searchResult.nbSeeders = -1;
 
-    searchResult.nbLeechers = parts.at(PL_LEECHS).trimmed().toLongLong(&ok); // Leechers
+    searchResult.nbLeechers = toLongLong(parts[PL_LEECHS], &ok); // Leechers
     if (!ok || (searchResult.nbLeechers < 0))
         searchResult.nbLeechers = -1;
 
-    searchResult.siteUrl = parts.at(PL_ENGINE_URL).trimmed().toString(); // Search site URL
+    searchResult.siteUrl = toString(parts[PL_ENGINE_URL]); // Search site URL
     if (nbFields == NB_PLUGIN_COLUMNS)
-        searchResult.descrLink = parts.at(PL_DESC_LINK).trimmed().toString(); // Description Link
+        searchResult.descrLink = toString(parts[PL_DESC_LINK]); // Description Link
 
     return true;
 }
@@ -197,7 +242,7 @@ SearchPluginManager *SearchHandler::manager() const
     return m_manager;
 }
 
-QList<SearchResult> SearchHandler::results() const
+const SearchResultStore &SearchHandler::results() const
 {
     return m_results;
 }
@@ -35,20 +35,11 @@
 #include <QString>
 #include <QtContainerFwd>
 
+#include "searchresultstore.h"
+
 class QProcess;
 class QTimer;
 
-struct SearchResult
-{
-    QString fileName;
-    QString fileUrl;
-    qlonglong fileSize;
-    qlonglong nbSeeders;
-    qlonglong nbLeechers;
-    QString siteUrl;
-    QString descrLink;
-};
-
 class SearchPluginManager;
 
 class SearchHandler : public QObject
@@ -65,20 +56,21 @@ public:
     bool isActive() const;
     QString pattern() const;
     SearchPluginManager *manager() const;
-    QList<SearchResult> results() const;
+    const SearchResultStore &results() const;
 
     void cancelSearch();
 
 signals:
     void searchFinished(bool cancelled = false);
     void searchFailed();
-    void newSearchResults(const QVector<SearchResult> &results);
+    // results in range [first, last] have been added
+    void newSearchResults(int first, int last);
 
 private:
     void readSearchOutput();
     void processFailed();
     void processFinished(int exitcode);
-    bool parseSearchResult(const QString &line, SearchResult &searchResult);
+    bool parseSearchResult(const char *begin, const char *end, SearchResult &searchResult) const;
 
     const QString m_pattern;
     const QString m_category;
@@ -86,7 +78,7 @@ private:
     SearchPluginManager *m_manager;
     QProcess *m_searchProcess;
     QTimer *m_searchTimeout;
-    QByteArray m_searchResultLineTruncated;
+    QByteArray m_searchOutput;
     bool m_searchCancelled = false;
-    QList<SearchResult> m_results;
+    SearchResultStore m_results;
 };
@@ -0,0 +1,109 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "searchresultstore.h"
+
+int SearchResultStore::size() const
+{
+    return m_fileNames.size();
+}
+
+bool SearchResultStore::isEmpty() const
+{
+    return m_fileNames.isEmpty();
+}
+
+void SearchResultStore::append(const SearchResult &result)
+{
+    int siteUrlIndex = m_siteUrlIndexByUrl.value(result.siteUrl, -1);
+    if (siteUrlIndex < 0)
+    {
+        siteUrlIndex = m_siteUrls.size();
+        m_siteUrls.append(result.siteUrl);
+        m_siteUrlIndexByUrl.insert(result.siteUrl, siteUrlIndex);
+    }
+
+    m_fileNames.append(result.fileName);
+    m_fileUrls.append(result.fileUrl);
+    m_fileSizes.append(result.fileSize);
+    m_nbSeeders.append(result.nbSeeders);
+    m_nbLeechers.append(result.nbLeechers);
+    m_siteUrlIndexes.append(siteUrlIndex);
+    m_descrLinks.append(result.descrLink);
+}
+
+SearchResult SearchResultStore::at(const int index) const
+{
+    return {fileName(index), fileUrl(index), fileSize(index), nbSeeders(index)
+            , nbLeechers(index), siteUrl(index), descrLink(index)};
+}
+
+QString SearchResultStore::fileName(const int index) const
+{
+    return m_fileNames.at(index);
+}
+
+QString SearchResultStore::fileUrl(const int index) const
+{
+    return m_fileUrls.at(index);
+}
+
+qlonglong SearchResultStore::fileSize(const int index) const
+{
+    return m_fileSizes.at(index);
+}
+
+qlonglong SearchResultStore::nbSeeders(const int index) const
+{
+    return m_nbSeeders.at(index);
+}
+
+qlonglong SearchResultStore::nbLeechers(const int index) const
+{
+    return m_nbLeechers.at(index);
+}
+
+QString SearchResultStore::siteUrl(const int index) const
+{
+    return m_siteUrls.at(m_siteUrlIndexes.at(index));
+}
+
+QString SearchResultStore::descrLink(const int index) const
+{
+    return m_descrLinks.at(index);
+}
+
+int SearchResultStore::siteUrlIndex(const int index) const
+{
+    return m_siteUrlIndexes.at(index);
+}
+
+QVector<QString> SearchResultStore::siteUrls() const
+{
+    return m_siteUrls;
+}
@@ -0,0 +1,80 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+struct SearchResult
+{
+    QString fileName;
+    QString fileUrl;
+    qlonglong fileSize;
+    qlonglong nbSeeders;
+    qlonglong nbLeechers;
+    QString siteUrl;
+    QString descrLink;
+};
+
+// Keeps search results column by column. Search engine URLs are
+// stored once and referenced by their index from every result.
+class SearchResultStore
+{
+public:
+    int size() const;
+    bool isEmpty() const;
+
+    void append(const SearchResult &result);
+    SearchResult at(int index) const;
+
+    QString fileName(int index) const;
+    QString fileUrl(int index) const;
+    qlonglong fileSize(int index) const;
+    qlonglong nbSeeders(int index) const;
+    qlonglong nbLeechers(int index) const;
+    QString siteUrl(int index) const;
+    QString descrLink(int index) const;
+
+    // index of the result's search engine URL in siteUrls()
+    int siteUrlIndex(int index) const;
+    QVector<QString> siteUrls() const;
+
+private:
+    QVector<QString> m_fileNames;
+    QVector<QString> m_fileUrls;
+    QVector<qlonglong> m_fileSizes;
+    QVector<qlonglong> m_nbSeeders;
+    QVector<qlonglong> m_nbLeechers;
+    QVector<int> m_siteUrlIndexes;
+    QVector<QString> m_descrLinks;
+
+    QVector<QString> m_siteUrls;
+    QHash<QString, int> m_siteUrlIndexByUrl;
+};
@@ -66,6 +66,26 @@ TorrentFilter::TorrentFilter(const QString &filter, const TorrentIDSet &idSet, c
     setTypeByName(filter);
 }
 
+TorrentFilter::Type TorrentFilter::type() const
+{
+    return m_type;
+}
+
+QString TorrentFilter::category() const
+{
+    return m_category;
+}
+
+QString TorrentFilter::tag() const
+{
+    return m_tag;
+}
+
+TorrentIDSet TorrentFilter::torrentIDSet() const
+{
+    return m_idSet;
+}
+
 bool TorrentFilter::setType(Type type)
 {
     if (m_type != type)
@@ -150,12 +170,12 @@ bool TorrentFilter::match(const Torrent *const torrent) const
 {
     if (!torrent) return false;
 
-    return (matchState(torrent) && matchHash(torrent) && matchCategory(torrent) && matchTag(torrent));
+    return (matchState(m_type, torrent) && matchHash(torrent) && matchCategory(torrent) && matchTag(torrent));
 }
 
-bool TorrentFilter::matchState(const BitTorrent::Torrent *const torrent) const
+bool TorrentFilter::matchState(const Type type, const BitTorrent::Torrent *const torrent)
 {
-    switch (m_type)
+    switch (type)
     {
     case All:
         return true;
@@ -82,6 +82,11 @@ public:
     TorrentFilter(Type type, const TorrentIDSet &idSet = AnyID, const QString &category = AnyCategory, const QString &tag = AnyTag);
     TorrentFilter(const QString &filter, const TorrentIDSet &idSet = AnyID, const QString &category = AnyCategory, const QString &tags = AnyTag);
 
+    Type type() const;
+    QString category() const;
+    QString tag() const;
+    TorrentIDSet torrentIDSet() const;
+
     bool setType(Type type);
     bool setTypeByName(const QString &filter);
     bool setTorrentIDSet(const TorrentIDSet &idSet);
@@ -90,8 +95,9 @@ public:
 
     bool match(const BitTorrent::Torrent *torrent) const;
 
+    static bool matchState(Type type, const BitTorrent::Torrent *torrent);
+
 private:
-    bool matchState(const BitTorrent::Torrent *torrent) const;
     bool matchHash(const BitTorrent::Torrent *torrent) const;
     bool matchCategory(const BitTorrent::Torrent *torrent) const;
     bool matchTag(const BitTorrent::Torrent *torrent) const;
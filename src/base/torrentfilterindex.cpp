@@ -0,0 +1,266 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "torrentfilterindex.h"
+
+#include "base/bittorrent/session.h"
+#include "base/bittorrent/torrent.h"
+#include "base/global.h"
+
+using BitTorrent::Session;
+using BitTorrent::Torrent;
+
+namespace
+{
+    const int TYPE_COUNT = TorrentFilter::Errored + 1;
+
+    quint32 stateMask(const Torrent *torrent)
+    {
+        quint32 mask = 0;
+        for (int type = 0; type < TYPE_COUNT; ++type)
+        {
+            if (TorrentFilter::matchState(static_cast<TorrentFilter::Type>(type), torrent))
+                mask |= (1u << type);
+        }
+
+        return mask;
+    }
+
+    void removeFromSet(QHash<QString, QSet<Torrent *>> &sets, const QString &key, Torrent *torrent)
+    {
+        const auto iter = sets.find(key);
+        if (iter == sets.end())
+            return;
+
+        iter->remove(torrent);
+        if (iter->isEmpty())
+            sets.erase(iter);
+    }
+}
+
+TorrentFilterIndex::TorrentFilterIndex(Session *session)
+    : QObject {session}
+    , m_session {session}
+    , m_stateTorrents(TYPE_COUNT)
+{
+    connect(session, &Session::torrentLoaded, this, &TorrentFilterIndex::addTorrent);
+    connect(session, &Session::torrentAboutToBeRemoved, this, &TorrentFilterIndex::removeTorrent);
+    connect(session, &Session::torrentsUpdated, this, &TorrentFilterIndex::updateStates);
+    connect(session, &Session::torrentPaused, this, &TorrentFilterIndex::updateState);
+    connect(session, &Session::torrentResumed, this, &TorrentFilterIndex::updateState);
+    connect(session, &Session::torrentFinished, this, &TorrentFilterIndex::updateState);
+    connect(session, &Session::torrentFinishedChecking, this, &TorrentFilterIndex::updateState);
+    connect(session, &Session::torrentMetadataReceived, this, &TorrentFilterIndex::updateState);
+    connect(session, &Session::torrentCategoryChanged, this, &TorrentFilterIndex::handleTorrentCategoryChanged);
+    connect(session, &Session::torrentTagAdded, this, &TorrentFilterIndex::handleTorrentTagAdded);
+    connect(session, &Session::torrentTagRemoved, this, &TorrentFilterIndex::handleTorrentTagRemoved);
+}
+
+int TorrentFilterIndex::count(const TorrentFilter::Type type) const
+{
+    return m_stateTorrents[type].size();
+}
+
+QVector<Torrent *> TorrentFilterIndex::torrents(const TorrentFilter &filter) const
+{
+    // Start from the smallest of the indexed sets the filter refers to,
+    // the remaining conditions are checked by the filter itself
+    const TorrentSet *candidates = &m_stateTorrents[filter.type()];
+
+    TorrentSet categorySet;
+    if (!filter.category().isNull())
+    {
+        categorySet = categoryTorrents(filter.category());
+        if (categorySet.size() < candidates->size())
+            candidates = &categorySet;
+    }
+
+    if (!filter.tag().isNull())
+    {
+        const auto tagIter = m_tagTorrents.constFind(filter.tag());
+        if (tagIter == m_tagTorrents.cend())
+            return {};
+
+        if (tagIter->size() < candidates->size())
+            candidates = &tagIter.value();
+    }
+
+    QVector<Torrent *> result;
+
+    const TorrentIDSet idSet = filter.torrentIDSet();
+    if ((idSet != TorrentFilter::AnyID) && (idSet.size() < candidates->size()))
+    {
+        result.reserve(idSet.size());
+        for (const BitTorrent::TorrentID &id : idSet)
+        {
+            Torrent *torrent = m_session->findTorrent(id);
+            if (torrent && filter.match(torrent))
+                result.append(torrent);
+        }
+
+        return result;
+    }
+
+    result.reserve(candidates->size());
+    for (Torrent *torrent : asConst(*candidates))
+    {
+        if (filter.match(torrent))
+            result.append(torrent);
+    }
+
+    return result;
+}
+
+void TorrentFilterIndex::addTorrent(Torrent *const torrent)
+{
+    updateStateSets(torrent);
+
+    m_categoryTorrents[torrent->category()].insert(torrent);
+
+    const TagSet tags = torrent->tags();
+    if (tags.isEmpty())
+    {
+        m_tagTorrents[QString()].insert(torrent);
+    }
+    else
+    {
+        for (const QString &tag : tags)
+            m_tagTorrents[tag].insert(torrent);
+    }
+
+    emit stateCountsChanged();
+}
+
+void TorrentFilterIndex::removeTorrent(Torrent *const torrent)
+{
+    const quint32 mask = m_stateMasks.take(torrent);
+    for (int type = 0; type < TYPE_COUNT; ++type)
+    {
+        if (mask & (1u << type))
+            m_stateTorrents[type].remove(torrent);
+    }
+
+    removeFromSet(m_categoryTorrents, torrent->category(), torrent);
+
+    const TagSet tags = torrent->tags();
+    if (tags.isEmpty())
+    {
+        removeFromSet(m_tagTorrents, QString(), torrent);
+    }
+    else
+    {
+        for (const QString &tag : tags)
+            removeFromSet(m_tagTorrents, tag, torrent);
+    }
+
+    emit stateCountsChanged();
+}
+
+void TorrentFilterIndex::updateState(Torrent *const torrent)
+{
+    if (m_stateMasks.contains(torrent) && updateStateSets(torrent))
+        emit stateCountsChanged();
+}
+
+void TorrentFilterIndex::updateStates(const QVector<Torrent *> &torrents)
+{
+    bool changed = false;
+    for (Torrent *torrent : torrents)
+    {
+        if (m_stateMasks.contains(torrent) && updateStateSets(torrent))
+            changed = true;
+    }
+
+    if (changed)
+        emit stateCountsChanged();
+}
+
+void TorrentFilterIndex::handleTorrentCategoryChanged(Torrent *const torrent, const QString &oldCategory)
+{
+    removeFromSet(m_categoryTorrents, oldCategory, torrent);
+    m_categoryTorrents[torrent->category()].insert(torrent);
+}
+
+void TorrentFilterIndex::handleTorrentTagAdded(Torrent *const torrent, const QString &tag)
+{
+    removeFromSet(m_tagTorrents, QString(), torrent);
+    m_tagTorrents[tag].insert(torrent);
+}
+
+void TorrentFilterIndex::handleTorrentTagRemoved(Torrent *const torrent, const QString &tag)
+{
+    removeFromSet(m_tagTorrents, tag, torrent);
+    if (torrent->tags().isEmpty())
+        m_tagTorrents[QString()].insert(torrent);
+}
+
+bool TorrentFilterIndex::updateStateSets(Torrent *const torrent)
+{
+    quint32 &mask = m_stateMasks[torrent];
+    const quint32 newMask = stateMask(torrent);
+    const quint32 changedBits = (mask ^ newMask);
+    if (changedBits == 0)
+        return false;
+
+    for (int type = 0; type < TYPE_COUNT; ++type)
+    {
+        const quint32 bit = (1u << type);
+        if (!(changedBits & bit))
+            continue;
+
+        if (newMask & bit)
+            m_stateTorrents[type].insert(torrent);
+        else
+            m_stateTorrents[type].remove(torrent);
+    }
+
+    mask = newMask;
+    return true;
+}
+
+TorrentFilterIndex::TorrentSet TorrentFilterIndex::categoryTorrents(const QString &category) const
+{
+    if (category.isEmpty())
+        return m_categoryTorrents.value(QString());
+
+    if (!Session::isValidCategoryName(category))
+        return {};
+
+    TorrentSet result = m_categoryTorrents.value(category);
+    if (m_session->isSubcategoriesEnabled())
+    {
+        const QString prefix = category + '/';
+        for (auto iter = m_categoryTorrents.cbegin(); iter != m_categoryTorrents.cend(); ++iter)
+        {
+            if (iter.key().startsWith(prefix))
+                result.unite(iter.value());
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,81 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QVector>
+
+#include "torrentfilter.h"
+
+namespace BitTorrent
+{
+    class Session;
+    class Torrent;
+}
+
+// Keeps the sets of torrents matching each state filter, category and tag
+// up to date, so that filtering and counting don't need to scan all torrents.
+class TorrentFilterIndex final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TorrentFilterIndex)
+
+public:
+    explicit TorrentFilterIndex(BitTorrent::Session *session);
+
+    int count(TorrentFilter::Type type) const;
+    QVector<BitTorrent::Torrent *> torrents(const TorrentFilter &filter) const;
+
+signals:
+    void stateCountsChanged();
+
+private:
+    using TorrentSet = QSet<BitTorrent::Torrent *>;
+
+    void addTorrent(BitTorrent::Torrent *torrent);
+    void removeTorrent(BitTorrent::Torrent *torrent);
+    void updateState(BitTorrent::Torrent *torrent);
+    void updateStates(const QVector<BitTorrent::Torrent *> &torrents);
+    void handleTorrentCategoryChanged(BitTorrent::Torrent *torrent, const QString &oldCategory);
+    void handleTorrentTagAdded(BitTorrent::Torrent *torrent, const QString &tag);
+    void handleTorrentTagRemoved(BitTorrent::Torrent *torrent, const QString &tag);
+
+    bool updateStateSets(BitTorrent::Torrent *torrent);
+    TorrentSet categoryTorrents(const QString &category) const;
+
+    BitTorrent::Session *m_session = nullptr;
+    // bit N is set if the torrent matches TorrentFilter::Type N
+    QHash<BitTorrent::Torrent *, quint32> m_stateMasks;
+    QVector<TorrentSet> m_stateTorrents;
+    QHash<QString, TorrentSet> m_categoryTorrents;
+    // untagged torrents are stored under the empty tag
+    QHash<QString, TorrentSet> m_tagTorrents;
+};
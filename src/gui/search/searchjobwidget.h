@@ -36,12 +36,11 @@
 
 class QHeaderView;
 class QModelIndex;
-class QStandardItemModel;
 
 class LineEdit;
 class SearchHandler;
+class SearchResultModel;
 class SearchSortModel;
-struct SearchResult;
 
 template <typename T> class SettingValue;
 
@@ -99,7 +98,6 @@ private:
     void onItemDoubleClicked(const QModelIndex &index);
     void searchFinished(bool cancelled);
     void searchFailed();
-    void appendSearchResults(const QVector<SearchResult> &results);
     void updateResultsCount();
     void setStatus(Status value);
     void downloadTorrent(const QModelIndex &rowIndex);
@@ -121,7 +119,7 @@ private:
 
     Ui::SearchJobWidget *m_ui;
     SearchHandler *m_searchHandler;
-    QStandardItemModel *m_searchListModel;
+    SearchResultModel *m_searchListModel;
     SearchSortModel *m_proxyModel;
     LineEdit *m_lineEditSearchResultsFilter;
     Status m_status = Status::Ongoing;
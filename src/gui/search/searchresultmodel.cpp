@@ -0,0 +1,243 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "searchresultmodel.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QCoreApplication>
+#include <QVariant>
+
+#include "base/search/searchhandler.h"
+#include "base/utils/misc.h"
+#include "searchsortmodel.h"
+
+SearchResultModel::SearchResultModel(const SearchHandler *searchHandler, QObject *parent)
+    : QAbstractListModel {parent}
+    , m_results {searchHandler->results()}
+{
+#ifdef QBT_USE_QCOLLATOR
+    // must match Utils::Compare::NaturalCompare
+    m_collator.setNumericMode(true);
+    m_collator.setCaseSensitivity(Qt::CaseInsensitive);
+#endif
+
+    connect(searchHandler, &SearchHandler::newSearchResults, this, &SearchResultModel::addResults);
+
+    if (!m_results.isEmpty())
+        addResults(0, (m_results.size() - 1));
+}
+
+int SearchResultModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int SearchResultModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : SearchSortModel::NB_SEARCH_COLUMNS;
+}
+
+QVariant SearchResultModel::data(const QModelIndex &index, const int role) const
+{
+    if (!index.isValid() || (index.row() >= m_rowCount))
+        return {};
+
+    const int row = index.row();
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        switch (index.column())
+        {
+        case SearchSortModel::NAME:
+            return m_results.fileName(row);
+        case SearchSortModel::SIZE:
+            return Utils::Misc::friendlyUnit(m_results.fileSize(row));
+        case SearchSortModel::SEEDS:
+            return QString::number(m_results.nbSeeders(row));
+        case SearchSortModel::LEECHES:
+            return QString::number(m_results.nbLeechers(row));
+        case SearchSortModel::ENGINE_URL:
+            return m_results.siteUrl(row);
+        case SearchSortModel::DL_LINK:
+            return m_results.fileUrl(row);
+        case SearchSortModel::DESC_LINK:
+            return m_results.descrLink(row);
+        }
+        break;
+    case SearchSortModel::UnderlyingDataRole:
+        switch (index.column())
+        {
+        case SearchSortModel::NAME:
+            return m_results.fileName(row);
+        case SearchSortModel::SIZE:
+            return m_results.fileSize(row);
+        case SearchSortModel::SEEDS:
+            return m_results.nbSeeders(row);
+        case SearchSortModel::LEECHES:
+            return m_results.nbLeechers(row);
+        case SearchSortModel::ENGINE_URL:
+            return m_results.siteUrl(row);
+        case SearchSortModel::DL_LINK:
+            return m_results.fileUrl(row);
+        case SearchSortModel::DESC_LINK:
+            return m_results.descrLink(row);
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        switch (index.column())
+        {
+        case SearchSortModel::SIZE:
+        case SearchSortModel::SEEDS:
+        case SearchSortModel::LEECHES:
+            return QVariant {Qt::AlignRight | Qt::AlignVCenter};
+        }
+        break;
+    case Qt::ForegroundRole:
+        return m_rowForegrounds.value(row);
+    }
+
+    return {};
+}
+
+bool SearchResultModel::setData(const QModelIndex &index, const QVariant &value, const int role)
+{
+    if (!index.isValid() || (index.row() >= m_rowCount) || (role != Qt::ForegroundRole))
+        return false;
+
+    m_rowForegrounds[index.row()] = value;
+    emit dataChanged(this->index(index.row(), 0), this->index(index.row(), (columnCount() - 1)), {role});
+    return true;
+}
+
+QVariant SearchResultModel::headerData(const int section, const Qt::Orientation orientation, const int role) const
+{
+    if (orientation != Qt::Horizontal)
+        return {};
+
+    if (role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+        case SearchSortModel::NAME:
+            return QCoreApplication::translate("SearchJobWidget", "Name", "i.e: file name");
+        case SearchSortModel::SIZE:
+            return QCoreApplication::translate("SearchJobWidget", "Size", "i.e: file size");
+        case SearchSortModel::SEEDS:
+            return QCoreApplication::translate("SearchJobWidget", "Seeders", "i.e: Number of full sources");
+        case SearchSortModel::LEECHES:
+            return QCoreApplication::translate("SearchJobWidget", "Leechers", "i.e: Number of partial sources");
+        case SearchSortModel::ENGINE_URL:
+            return QCoreApplication::translate("SearchJobWidget", "Search engine");
+        default:
+            return {};
+        }
+    }
+
+    if (role == Qt::TextAlignmentRole)
+    {
+        switch (section)
+        {
+        case SearchSortModel::SIZE:
+        case SearchSortModel::SEEDS:
+        case SearchSortModel::LEECHES:
+            return QVariant {Qt::AlignRight | Qt::AlignVCenter};
+        default:
+            return {};
+        }
+    }
+
+    return {};
+}
+
+const SearchResultStore &SearchResultModel::results() const
+{
+    return m_results;
+}
+
+bool SearchResultModel::lessThan(const int column, const int leftRow, const int rightRow) const
+{
+    switch (column)
+    {
+    case SearchSortModel::NAME:
+#ifdef QBT_USE_QCOLLATOR
+        return (m_nameSortKeys[leftRow].compare(m_nameSortKeys[rightRow]) < 0);
+#else
+        return m_naturalLessThan(m_results.fileName(leftRow), m_results.fileName(rightRow));
+#endif
+    case SearchSortModel::SIZE:
+        return (m_results.fileSize(leftRow) < m_results.fileSize(rightRow));
+    case SearchSortModel::SEEDS:
+        return (m_results.nbSeeders(leftRow) < m_results.nbSeeders(rightRow));
+    case SearchSortModel::LEECHES:
+        return (m_results.nbLeechers(leftRow) < m_results.nbLeechers(rightRow));
+    case SearchSortModel::ENGINE_URL:
+        return (m_siteUrlRanks[m_results.siteUrlIndex(leftRow)] < m_siteUrlRanks[m_results.siteUrlIndex(rightRow)]);
+    case SearchSortModel::DL_LINK:
+        return (m_results.fileUrl(leftRow) < m_results.fileUrl(rightRow));
+    case SearchSortModel::DESC_LINK:
+        return (m_results.descrLink(leftRow) < m_results.descrLink(rightRow));
+    default:
+        return false;
+    }
+}
+
+void SearchResultModel::addResults(const int first, const int last)
+{
+    beginInsertRows({}, first, last);
+
+#ifdef QBT_USE_QCOLLATOR
+    m_nameSortKeys.reserve(last + 1);
+    for (int i = first; i <= last; ++i)
+        m_nameSortKeys.push_back(m_collator.sortKey(m_results.fileName(i)));
+#endif
+
+    if (m_siteUrlRanks.size() != m_results.siteUrls().size())
+        updateSiteUrlRanks();
+
+    m_rowCount = last + 1;
+    endInsertRows();
+}
+
+void SearchResultModel::updateSiteUrlRanks()
+{
+    const QVector<QString> siteUrls = m_results.siteUrls();
+
+    QVector<int> order(siteUrls.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this, &siteUrls](const int left, const int right)
+    {
+        return m_naturalLessThan(siteUrls[left], siteUrls[right]);
+    });
+
+    m_siteUrlRanks.resize(siteUrls.size());
+    for (int rank = 0; rank < order.size(); ++rank)
+        m_siteUrlRanks[order[rank]] = rank;
+}
@@ -0,0 +1,76 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVariant>
+#include <QVector>
+
+#include "base/utils/compare.h"
+
+class SearchHandler;
+class SearchResultStore;
+
+class SearchResultModel final : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(SearchResultModel)
+
+public:
+    explicit SearchResultModel(const SearchHandler *searchHandler, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = {}) const override;
+    int columnCount(const QModelIndex &parent = {}) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    const SearchResultStore &results() const;
+    bool lessThan(int column, int leftRow, int rightRow) const;
+
+private:
+    void addResults(int first, int last);
+    void updateSiteUrlRanks();
+
+    const SearchResultStore &m_results;
+    int m_rowCount = 0;
+
+    // Sort keys are computed once per result instead of on every comparison
+#ifdef QBT_USE_QCOLLATOR
+    QCollator m_collator;
+    std::vector<QCollatorSortKey> m_nameSortKeys;
+#endif
+    QVector<int> m_siteUrlRanks;
+    Utils::Compare::NaturalLessThan<Qt::CaseInsensitive> m_naturalLessThan;
+
+    QHash<int, QVariant> m_rowForegrounds;
+};
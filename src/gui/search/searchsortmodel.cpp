@@ -29,6 +29,8 @@
 #include "searchsortmodel.h"
 
 #include "base/global.h"
+#include "base/search/searchresultstore.h"
+#include "searchresultmodel.h"
 
 SearchSortModel::SearchSortModel(QObject *parent)
     : base(parent)
@@ -113,28 +115,17 @@ qint64 SearchSortModel::maxSize() const
 
 bool SearchSortModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
 {
-    switch (sortColumn())
-    {
-    case NAME:
-    case ENGINE_URL:
-        {
-            const QString strL = left.data().toString();
-            const QString strR = right.data().toString();
-            return m_naturalLessThan(strL, strR);
-        }
-        break;
-    default:
-        return base::lessThan(left, right);
-    };
+    const auto *resultModel = static_cast<const SearchResultModel *>(sourceModel());
+    return resultModel->lessThan(sortColumn(), left.row(), right.row());
 }
 
 bool SearchSortModel::filterAcceptsRow(const int sourceRow, const QModelIndex &sourceParent) const
 {
-    const QAbstractItemModel *const sourceModel = this->sourceModel();
+    const SearchResultStore &results = static_cast<const SearchResultModel *>(sourceModel())->results();
 
     if (m_isNameFilterEnabled && !m_searchTerm.isEmpty())
     {
-        const QString name = sourceModel->data(sourceModel->index(sourceRow, NAME, sourceParent), UnderlyingDataRole).toString();
+        const QString name = results.fileName(sourceRow);
         for (const QString &word : asConst(m_searchTermWords))
         {
             if (!name.contains(word, Qt::CaseInsensitive))
@@ -144,7 +135,7 @@ bool SearchSortModel::filterAcceptsRow(const int sourceRow, const QModelIndex &s
 
     if ((m_minSize > 0) || (m_maxSize >= 0))
     {
-        const qlonglong size = sourceModel->data(sourceModel->index(sourceRow, SIZE, sourceParent), UnderlyingDataRole).toLongLong();
+        const qlonglong size = results.fileSize(sourceRow);
         if (((m_minSize > 0) && (size < m_minSize))
             || ((m_maxSize > 0) && (size > m_maxSize)))
             return false;
@@ -152,7 +143,7 @@ bool SearchSortModel::filterAcceptsRow(const int sourceRow, const QModelIndex &s
 
     if ((m_minSeeds > 0) || (m_maxSeeds >= 0))
     {
-        const int seeds = sourceModel->data(sourceModel->index(sourceRow, SEEDS, sourceParent), UnderlyingDataRole).toInt();
+        const qlonglong seeds = results.nbSeeders(sourceRow);
         if (((m_minSeeds > 0) && (seeds < m_minSeeds))
             || ((m_maxSeeds > 0) && (seeds > m_maxSeeds)))
             return false;
@@ -160,7 +151,7 @@ bool SearchSortModel::filterAcceptsRow(const int sourceRow, const QModelIndex &s
 
     if ((m_minLeeches > 0) || (m_maxLeeches >= 0))
     {
-        const int leeches = sourceModel->data(sourceModel->index(sourceRow, LEECHES, sourceParent), UnderlyingDataRole).toInt();
+        const qlonglong leeches = results.nbLeechers(sourceRow);
         if (((m_minLeeches > 0) && (leeches < m_minLeeches))
             || ((m_maxLeeches > 0) && (leeches > m_maxLeeches)))
             return false;
@@ -32,7 +32,10 @@
 
 #include <QFileIconProvider>
 #include <QFileInfo>
+#include <QHash>
 #include <QIcon>
+#include <QPair>
+#include <QSet>
 
 #if defined(Q_OS_WIN)
 #include <Windows.h>
@@ -214,13 +217,21 @@ void TorrentContentModel::updateFilesProgress(const QVector<qreal> &fp)
     // XXX: Why is this necessary?
     if (m_filesIndex.size() != fp.size()) return;
 
-    emit layoutAboutToBeChanged();
+    QVector<TorrentContentModelItem *> changedItems;
     for (int i = 0; i < fp.size(); ++i)
-        m_filesIndex[i]->setProgress(fp[i]);
-    // Update folders progress in the tree
-    m_rootItem->recalculateProgress();
-    m_rootItem->recalculateAvailability();
-    emit dataChanged(index(0, 0), index((rowCount() - 1), (columnCount() - 1)));
+    {
+        if (m_filesIndex[i]->setProgress(fp[i]))
+            changedItems.append(m_filesIndex[i]);
+    }
+
+    // Update progress of the folders containing changed files only
+    for (TorrentContentModelFolder *folder : asConst(affectedFolders(changedItems)))
+    {
+        folder->updateProgress();
+        changedItems.append(folder);
+    }
+
+    notifyItemsChanged(changedItems, TorrentContentModelItem::COL_PROGRESS, TorrentContentModelItem::COL_REMAINING);
 }
 
 void TorrentContentModel::updateFilesPriorities(const QVector<BitTorrent::DownloadPriority> &fprio)
@@ -233,6 +244,9 @@ void TorrentContentModel::updateFilesPriorities(const QVector<BitTorrent::Downlo
     emit layoutAboutToBeChanged();
     for (int i = 0; i < fprio.size(); ++i)
         m_filesIndex[i]->setPriority(static_cast<BitTorrent::DownloadPriority>(fprio[i]));
+    // Priorities decide which files count for folders, so the whole tree is affected
+    m_rootItem->recalculateProgress();
+    m_rootItem->recalculateAvailability();
     emit dataChanged(index(0, 0), index((rowCount() - 1), (columnCount() - 1)));
 }
 
@@ -242,12 +256,85 @@ void TorrentContentModel::updateFilesAvailability(const QVector<qreal> &fa)
     // XXX: Why is this necessary?
     if (m_filesIndex.size() != fa.size()) return;
 
-    emit layoutAboutToBeChanged();
+    QVector<TorrentContentModelItem *> changedItems;
     for (int i = 0; i < m_filesIndex.size(); ++i)
-        m_filesIndex[i]->setAvailability(fa[i]);
-    // Update folders progress in the tree
-    m_rootItem->recalculateProgress();
-    emit dataChanged(index(0, 0), index((rowCount() - 1), (columnCount() - 1)));
+    {
+        if (m_filesIndex[i]->setAvailability(fa[i]))
+            changedItems.append(m_filesIndex[i]);
+    }
+
+    // Update availability of the folders containing changed files only
+    for (TorrentContentModelFolder *folder : asConst(affectedFolders(changedItems)))
+    {
+        folder->updateAvailability();
+        changedItems.append(folder);
+    }
+
+    notifyItemsChanged(changedItems, TorrentContentModelItem::COL_AVAILABILITY, TorrentContentModelItem::COL_AVAILABILITY);
+}
+
+// Returns the ancestor folders of the given items ordered so that
+// any folder comes before its parent
+QVector<TorrentContentModelFolder *> TorrentContentModel::affectedFolders(const QVector<TorrentContentModelItem *> &items) const
+{
+    QSet<TorrentContentModelFolder *> visited;
+    QVector<QPair<int, TorrentContentModelFolder *>> folders;
+    for (const TorrentContentModelItem *item : items)
+    {
+        for (TorrentContentModelFolder *folder = item->parent(); folder != m_rootItem; folder = folder->parent())
+        {
+            if (visited.contains(folder))
+                break;
+
+            visited.insert(folder);
+
+            int depth = 0;
+            for (const TorrentContentModelFolder *ancestor = folder->parent(); ancestor != m_rootItem; ancestor = ancestor->parent())
+                ++depth;
+            folders.append({depth, folder});
+        }
+    }
+
+    std::sort(folders.begin(), folders.end(), [](const auto &left, const auto &right)
+    {
+        return (left.first > right.first);
+    });
+
+    QVector<TorrentContentModelFolder *> result;
+    result.reserve(folders.size());
+    for (const auto &folder : asConst(folders))
+        result.append(folder.second);
+    return result;
+}
+
+// Emits dataChanged() for the given columns of the changed items,
+// one signal per span of rows sharing the same parent
+void TorrentContentModel::notifyItemsChanged(const QVector<TorrentContentModelItem *> &items, const int firstColumn, const int lastColumn)
+{
+    QHash<TorrentContentModelFolder *, QPair<int, int>> rowSpans;
+    for (const TorrentContentModelItem *item : items)
+    {
+        const int row = item->row();
+        const auto spanIter = rowSpans.find(item->parent());
+        if (spanIter == rowSpans.end())
+        {
+            rowSpans.insert(item->parent(), {row, row});
+        }
+        else
+        {
+            spanIter->first = std::min(spanIter->first, row);
+            spanIter->second = std::max(spanIter->second, row);
+        }
+    }
+
+    for (auto iter = rowSpans.cbegin(); iter != rowSpans.cend(); ++iter)
+    {
+        TorrentContentModelFolder *parentItem = iter.key();
+        const QModelIndex parentIndex = (parentItem == m_rootItem)
+            ? QModelIndex()
+            : createIndex(parentItem->row(), 0, parentItem);
+        emit dataChanged(index(iter->first, firstColumn, parentIndex), index(iter->second, lastColumn, parentIndex));
+    }
 }
 
 QVector<BitTorrent::DownloadPriority> TorrentContentModel::getFilePriorities() const
@@ -495,30 +582,41 @@ void TorrentContentModel::setupModelData(const BitTorrent::TorrentInfo &info)
     qDebug("Torrent contains %d files", filesCount);
     m_filesIndex.reserve(filesCount);
 
-    TorrentContentModelFolder *currentParent;
+    // Files of a torrent are usually grouped by folder, so the folder of
+    // the previous file is remembered and the path is only resolved again
+    // when the folder part changes
+    QString currentFolderPath;
+    TorrentContentModelFolder *currentParent = m_rootItem;
     // Iterate over files
     for (int i = 0; i < filesCount; ++i)
     {
-        currentParent = m_rootItem;
         const QString path = Utils::Fs::toUniformPath(info.filePath(i));
+        const int slashIndex = path.lastIndexOf('/');
+        const QStringRef folderPath = path.leftRef(slashIndex + 1);
 
-        // Iterate of parts of the path to create necessary folders
-        QVector<QStringRef> pathFolders = path.splitRef('/', Qt::SkipEmptyParts);
-        pathFolders.removeLast();
-
-        for (const QStringRef &pathPartRef : asConst(pathFolders))
+        if (folderPath != currentFolderPath)
         {
-            const QString pathPart = pathPartRef.toString();
-            TorrentContentModelFolder *newParent = currentParent->childFolderWithName(pathPart);
-            if (!newParent)
+            currentParent = m_rootItem;
+
+            // Iterate of parts of the path to create necessary folders
+            const QVector<QStringRef> pathFolders = folderPath.split('/', Qt::SkipEmptyParts);
+            for (const QStringRef &pathPartRef : pathFolders)
             {
-                newParent = new TorrentContentModelFolder(pathPart, currentParent);
-                currentParent->appendChild(newParent);
+                const QString pathPart = pathPartRef.toString();
+                TorrentContentModelFolder *newParent = currentParent->childFolderWithName(pathPart);
+                if (!newParent)
+                {
+                    newParent = new TorrentContentModelFolder(pathPart, currentParent);
+                    currentParent->appendChild(newParent);
+                }
+                currentParent = newParent;
             }
-            currentParent = newParent;
+
+            currentFolderPath = folderPath.toString();
         }
+
         // Actually create the file
-        TorrentContentModelFile *fileItem = new TorrentContentModelFile(info.fileName(i), info.fileSize(i), currentParent, i);
+        TorrentContentModelFile *fileItem = new TorrentContentModelFile(path.mid(slashIndex + 1), info.fileSize(i), currentParent, i);
         currentParent->appendChild(fileItem);
         m_filesIndex.push_back(fileItem);
     }
@@ -45,6 +45,7 @@ TorrentContentModelFile::TorrentContentModelFile(const QString &fileName, qulong
         m_name.chop(4);
 
     m_size = fileSize;
+    m_remaining = fileSize;
 }
 
 int TorrentContentModelFile::fileIndex() const
@@ -66,17 +67,25 @@ void TorrentContentModelFile::setPriority(BitTorrent::DownloadPriority newPriori
         m_parentItem->updatePriority();
 }
 
-void TorrentContentModelFile::setProgress(qreal progress)
+bool TorrentContentModelFile::setProgress(qreal progress)
 {
+    if (m_progress == progress)
+        return false;
+
     m_progress = progress;
     m_remaining = static_cast<qulonglong>(m_size * (1.0 - m_progress));
     Q_ASSERT(m_progress <= 1.);
+    return true;
 }
 
-void TorrentContentModelFile::setAvailability(const qreal availability)
+bool TorrentContentModelFile::setAvailability(const qreal availability)
 {
+    if (m_availability == availability)
+        return false;
+
     m_availability = availability;
     Q_ASSERT(m_availability <= 1.);
+    return true;
 }
 
 TorrentContentModelItem::ItemType TorrentContentModelFile::itemType() const
@@ -43,8 +43,9 @@ public:
 
     int fileIndex() const;
     void setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent = true) override;
-    void setProgress(qreal progress);
-    void setAvailability(qreal availability);
+    // return false if the value is unchanged
+    bool setProgress(qreal progress);
+    bool setAvailability(qreal availability);
     ItemType itemType() const override;
 
 private:
@@ -65,6 +65,7 @@ void TorrentContentModelFolder::deleteAllChildren()
     Q_ASSERT(isRootItem());
     qDeleteAll(m_childItems);
     m_childItems.clear();
+    m_childFolders.clear();
 }
 
 const QVector<TorrentContentModelItem *> &TorrentContentModelFolder::children() const
@@ -75,10 +76,13 @@ const QVector<TorrentContentModelItem *> &TorrentContentModelFolder::children()
 void TorrentContentModelFolder::appendChild(TorrentContentModelItem *item)
 {
     Q_ASSERT(item);
+    item->m_row = m_childItems.size();
     m_childItems.append(item);
     // Update own size
     if (item->itemType() == FileType)
         increaseSize(item->size());
+    else if (!m_childFolders.contains(item->name()))
+        m_childFolders.insert(item->name(), static_cast<TorrentContentModelFolder *>(item));
 }
 
 TorrentContentModelItem *TorrentContentModelFolder::child(int row) const
@@ -88,12 +92,27 @@ TorrentContentModelItem *TorrentContentModelFolder::child(int row) const
 
 TorrentContentModelFolder *TorrentContentModelFolder::childFolderWithName(const QString &name) const
 {
-    for (TorrentContentModelItem *child : asConst(m_childItems))
+    return m_childFolders.value(name, nullptr);
+}
+
+void TorrentContentModelFolder::handleChildFolderRenamed(TorrentContentModelFolder *folder, const QString &oldName)
+{
+    if (m_childFolders.value(oldName) == folder)
     {
-        if ((child->itemType() == FolderType) && (child->name() == name))
-            return static_cast<TorrentContentModelFolder *>(child);
+        m_childFolders.remove(oldName);
+        // Some other child folder may have the same name
+        for (TorrentContentModelItem *child : asConst(m_childItems))
+        {
+            if ((child != folder) && (child->itemType() == FolderType) && (child->name() == oldName))
+            {
+                m_childFolders.insert(oldName, static_cast<TorrentContentModelFolder *>(child));
+                break;
+            }
+        }
     }
-    return nullptr;
+
+    if (!m_childFolders.contains(folder->name()))
+        m_childFolders.insert(folder->name(), folder);
 }
 
 int TorrentContentModelFolder::childCount() const
@@ -144,6 +163,17 @@ void TorrentContentModelFolder::setPriority(BitTorrent::DownloadPriority newPrio
 }
 
 void TorrentContentModelFolder::recalculateProgress()
+{
+    for (TorrentContentModelItem *child : asConst(m_childItems))
+    {
+        if ((child->priority() != BitTorrent::DownloadPriority::Ignored) && (child->itemType() == FolderType))
+            static_cast<TorrentContentModelFolder *>(child)->recalculateProgress();
+    }
+
+    updateProgress();
+}
+
+void TorrentContentModelFolder::updateProgress()
 {
     qreal tProgress = 0;
     qulonglong tSize = 0;
@@ -153,8 +183,6 @@ void TorrentContentModelFolder::recalculateProgress()
         if (child->priority() == BitTorrent::DownloadPriority::Ignored)
             continue;
 
-        if (child->itemType() == FolderType)
-            static_cast<TorrentContentModelFolder *>(child)->recalculateProgress();
         tProgress += child->progress() * child->size();
         tSize += child->size();
         tRemaining += child->remaining();
@@ -169,6 +197,17 @@ void TorrentContentModelFolder::recalculateProgress()
 }
 
 void TorrentContentModelFolder::recalculateAvailability()
+{
+    for (TorrentContentModelItem *child : asConst(m_childItems))
+    {
+        if ((child->priority() != BitTorrent::DownloadPriority::Ignored) && (child->itemType() == FolderType))
+            static_cast<TorrentContentModelFolder *>(child)->recalculateAvailability();
+    }
+
+    updateAvailability();
+}
+
+void TorrentContentModelFolder::updateAvailability()
 {
     qreal tAvailability = 0;
     qulonglong tSize = 0;
@@ -178,8 +217,6 @@ void TorrentContentModelFolder::recalculateAvailability()
         if (child->priority() == BitTorrent::DownloadPriority::Ignored)
             continue;
 
-        if (child->itemType() == FolderType)
-            static_cast<TorrentContentModelFolder*>(child)->recalculateAvailability();
         const qreal childAvailability = child->availability();
         if (childAvailability >= 0)
         { // -1 means "no data"
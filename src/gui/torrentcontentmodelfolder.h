@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <QHash>
+
 #include "torrentcontentmodelitem.h"
 
 namespace BitTorrent
@@ -51,6 +53,9 @@ public:
     void increaseSize(qulonglong delta);
     void recalculateProgress();
     void recalculateAvailability();
+    // Same as above but only for this folder, using the current values of its children
+    void updateProgress();
+    void updateAvailability();
     void updatePriority();
 
     void setPriority(BitTorrent::DownloadPriority newPriority, bool updateParent = true) override;
@@ -60,8 +65,11 @@ public:
     void appendChild(TorrentContentModelItem *item);
     TorrentContentModelItem *child(int row) const;
     TorrentContentModelFolder *childFolderWithName(const QString &name) const;
+    void handleChildFolderRenamed(TorrentContentModelFolder *folder, const QString &oldName);
     int childCount() const;
 
 private:
     QVector<TorrentContentModelItem*> m_childItems;
+    // Child folders by name, so the tree can be built without scanning siblings
+    QHash<QString, TorrentContentModelFolder *> m_childFolders;
 };
@@ -28,6 +28,8 @@
 
 #include "torrentcontentmodelitem.h"
 
+#include <utility>
+
 #include <QVariant>
 
 #include "base/unicodestrings.h"
@@ -42,6 +44,7 @@ TorrentContentModelItem::TorrentContentModelItem(TorrentContentModelFolder *pare
     , m_priority(BitTorrent::DownloadPriority::Normal)
     , m_progress(0)
     , m_availability(-1.)
+    , m_row(0)
 {
 }
 
@@ -61,7 +64,12 @@ QString TorrentContentModelItem::name() const
 void TorrentContentModelItem::setName(const QString &name)
 {
     Q_ASSERT(!isRootItem());
-    m_name = name;
+    if (m_name == name)
+        return;
+
+    const QString oldName = std::exchange(m_name, name);
+    if (itemType() == FolderType)
+        m_parentItem->handleChildFolderRenamed(static_cast<TorrentContentModelFolder *>(this), oldName);
 }
 
 qulonglong TorrentContentModelItem::size() const
@@ -177,9 +185,7 @@ QVariant TorrentContentModelItem::underlyingData(const int column) const
 
 int TorrentContentModelItem::row() const
 {
-    if (m_parentItem)
-        return m_parentItem->children().indexOf(const_cast<TorrentContentModelItem *>(this));
-    return 0;
+    return m_row;
 }
 
 TorrentContentModelFolder *TorrentContentModelItem::parent() const
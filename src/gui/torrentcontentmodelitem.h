@@ -40,6 +40,7 @@ class TorrentContentModelFolder;
 class TorrentContentModelItem
 {
     Q_DECLARE_TR_FUNCTIONS(TorrentContentModelItem)
+    friend class TorrentContentModelFolder;
 
 public:
     enum TreeItemColumns
@@ -94,4 +95,7 @@ protected:
     BitTorrent::DownloadPriority m_priority;
     qreal m_progress;
     qreal m_availability;
+
+private:
+    int m_row;
 };
@@ -196,7 +196,7 @@ void SearchController::resultsAction()
         throw APIError(APIErrorType::NotFound);
 
     const SearchHandlerPtr searchHandler = searchHandlers[id];
-    const QList<SearchResult> searchResults = searchHandler->results();
+    const SearchResultStore &searchResults = searchHandler->results();
     const int size = searchResults.size();
 
     if (offset > size)
@@ -210,10 +210,8 @@ void SearchController::resultsAction()
     if (limit <= 0)
         limit = -1;
 
-    if ((limit > 0) || (offset > 0))
-        setResult(getResults(searchResults.mid(offset, limit), searchHandler->isActive(), size));
-    else
-        setResult(getResults(searchResults, searchHandler->isActive(), size));
+    const int count = ((limit > 0) && (limit < (size - offset))) ? limit : (size - offset);
+    setResult(getResults(searchResults, offset, count, searchHandler->isActive()));
 }
 
 void SearchController::deleteAction()
@@ -337,20 +335,20 @@ int SearchController::generateSearchId() const
  *   - "siteUrl"
  *   - "descrLink"
  */
-QJsonObject SearchController::getResults(const QList<SearchResult> &searchResults, const bool isSearchActive, const int totalResults) const
+QJsonObject SearchController::getResults(const SearchResultStore &searchResults, const int offset, const int count, const bool isSearchActive) const
 {
     QJsonArray searchResultsArray;
-    for (const SearchResult &searchResult : searchResults)
+    for (int i = offset; i < (offset + count); ++i)
     {
         searchResultsArray << QJsonObject
         {
-            {"fileName", searchResult.fileName},
-            {"fileUrl", searchResult.fileUrl},
-            {"fileSize", searchResult.fileSize},
-            {"nbSeeders", searchResult.nbSeeders},
-            {"nbLeechers", searchResult.nbLeechers},
-            {"siteUrl", searchResult.siteUrl},
-            {"descrLink", searchResult.descrLink}
+            {"fileName", searchResults.fileName(i)},
+            {"fileUrl", searchResults.fileUrl(i)},
+            {"fileSize", searchResults.fileSize(i)},
+            {"nbSeeders", searchResults.nbSeeders(i)},
+            {"nbLeechers", searchResults.nbLeechers(i)},
+            {"siteUrl", searchResults.siteUrl(i)},
+            {"descrLink", searchResults.descrLink(i)}
         };
     }
 
@@ -358,7 +356,7 @@ QJsonObject SearchController::getResults(const QList<SearchResult> &searchResult
     {
         {"status", isSearchActive ? "Running" : "Stopped"},
         {"results", searchResultsArray},
-        {"total", totalResults}
+        {"total", searchResults.size()}
     };
 
     return result;
@@ -37,7 +37,7 @@ class QJsonArray;
 class QJsonObject;
 
 struct ISession;
-struct SearchResult;
+class SearchResultStore;
 
 class SearchController : public APIController
 {
@@ -67,6 +67,6 @@ private:
     void searchFinished(ISession *session, int id);
     void searchFailed(ISession *session, int id);
     int generateSearchId() const;
-    QJsonObject getResults(const QList<SearchResult> &searchResults, bool isSearchActive, int totalResults) const;
+    QJsonObject getResults(const SearchResultStore &searchResults, int offset, int count, bool isSearchActive) const;
     QJsonArray getPluginsInfo(const QStringList &plugins) const;
 };
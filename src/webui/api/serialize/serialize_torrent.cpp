@@ -29,123 +29,188 @@
 #include "serialize_torrent.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QVector>
 
 #include "base/bittorrent/infohash.h"
 #include "base/bittorrent/torrent.h"
 #include "base/bittorrent/trackerentry.h"
+#include "base/global.h"
 #include "base/tagset.h"
 #include "base/utils/fs.h"
 
-namespace
+QString torrentStateToString(const BitTorrent::TorrentState state)
 {
-    QString torrentStateToString(const BitTorrent::TorrentState state)
+    switch (state)
     {
-        switch (state)
-        {
-        case BitTorrent::TorrentState::Error:
-            return QLatin1String("error");
-        case BitTorrent::TorrentState::MissingFiles:
-            return QLatin1String("missingFiles");
-        case BitTorrent::TorrentState::Uploading:
-            return QLatin1String("uploading");
-        case BitTorrent::TorrentState::PausedUploading:
-            return QLatin1String("pausedUP");
-        case BitTorrent::TorrentState::QueuedUploading:
-            return QLatin1String("queuedUP");
-        case BitTorrent::TorrentState::StalledUploading:
-            return QLatin1String("stalledUP");
-        case BitTorrent::TorrentState::CheckingUploading:
-            return QLatin1String("checkingUP");
-        case BitTorrent::TorrentState::ForcedUploading:
-            return QLatin1String("forcedUP");
-        case BitTorrent::TorrentState::Downloading:
-            return QLatin1String("downloading");
-        case BitTorrent::TorrentState::DownloadingMetadata:
-            return QLatin1String("metaDL");
-        case BitTorrent::TorrentState::PausedDownloading:
-            return QLatin1String("pausedDL");
-        case BitTorrent::TorrentState::QueuedDownloading:
-            return QLatin1String("queuedDL");
-        case BitTorrent::TorrentState::StalledDownloading:
-            return QLatin1String("stalledDL");
-        case BitTorrent::TorrentState::CheckingDownloading:
-            return QLatin1String("checkingDL");
-        case BitTorrent::TorrentState::ForcedDownloading:
-            return QLatin1String("forcedDL");
-        case BitTorrent::TorrentState::CheckingResumeData:
-            return QLatin1String("checkingResumeData");
-        case BitTorrent::TorrentState::Moving:
-            return QLatin1String("moving");
-        default:
-            return QLatin1String("unknown");
-        }
+    case BitTorrent::TorrentState::Error:
+        return QLatin1String("error");
+    case BitTorrent::TorrentState::MissingFiles:
+        return QLatin1String("missingFiles");
+    case BitTorrent::TorrentState::Uploading:
+        return QLatin1String("uploading");
+    case BitTorrent::TorrentState::PausedUploading:
+        return QLatin1String("pausedUP");
+    case BitTorrent::TorrentState::QueuedUploading:
+        return QLatin1String("queuedUP");
+    case BitTorrent::TorrentState::StalledUploading:
+        return QLatin1String("stalledUP");
+    case BitTorrent::TorrentState::CheckingUploading:
+        return QLatin1String("checkingUP");
+    case BitTorrent::TorrentState::ForcedUploading:
+        return QLatin1String("forcedUP");
+    case BitTorrent::TorrentState::Downloading:
+        return QLatin1String("downloading");
+    case BitTorrent::TorrentState::DownloadingMetadata:
+        return QLatin1String("metaDL");
+    case BitTorrent::TorrentState::PausedDownloading:
+        return QLatin1String("pausedDL");
+    case BitTorrent::TorrentState::QueuedDownloading:
+        return QLatin1String("queuedDL");
+    case BitTorrent::TorrentState::StalledDownloading:
+        return QLatin1String("stalledDL");
+    case BitTorrent::TorrentState::CheckingDownloading:
+        return QLatin1String("checkingDL");
+    case BitTorrent::TorrentState::ForcedDownloading:
+        return QLatin1String("forcedDL");
+    case BitTorrent::TorrentState::CheckingResumeData:
+        return QLatin1String("checkingResumeData");
+    case BitTorrent::TorrentState::Moving:
+        return QLatin1String("moving");
+    default:
+        return QLatin1String("unknown");
     }
 }
 
-QVariantMap serialize(const BitTorrent::Torrent &torrent)
+namespace
 {
-    const auto adjustQueuePosition = [](const int position) -> int
+    struct TorrentField
     {
-        return (position < 0) ? 0 : (position + 1);
+        const char *key;
+        TorrentFieldGetter getter;
     };
 
-    const auto adjustRatio = [](const qreal ratio) -> qreal
+    using BitTorrent::Torrent;
+
+    const TorrentField TORRENT_FIELDS[] =
     {
-        return (ratio > BitTorrent::Torrent::MAX_RATIO) ? -1 : ratio;
-    };
+        {KEY_TORRENT_ID, [](const Torrent &torrent) -> QVariant { return torrent.id().toString(); }},
+        {KEY_TORRENT_INFOHASHV1, [](const Torrent &torrent) -> QVariant { return torrent.infoHash().v1().toString(); }},
+        {KEY_TORRENT_INFOHASHV2, [](const Torrent &torrent) -> QVariant { return torrent.infoHash().v2().toString(); }},
+        {KEY_TORRENT_NAME, [](const Torrent &torrent) -> QVariant { return torrent.name(); }},
+        {KEY_TORRENT_MAGNET_URI, [](const Torrent &torrent) -> QVariant { return torrent.createMagnetURI(); }},
+        {KEY_TORRENT_SIZE, [](const Torrent &torrent) -> QVariant { return torrent.wantedSize(); }},
+        {KEY_TORRENT_PROGRESS, [](const Torrent &torrent) -> QVariant { return torrent.progress(); }},
+        {KEY_TORRENT_DLSPEED, [](const Torrent &torrent) -> QVariant { return torrent.downloadPayloadRate(); }},
+        {KEY_TORRENT_UPSPEED, [](const Torrent &torrent) -> QVariant { return torrent.uploadPayloadRate(); }},
+        {KEY_TORRENT_QUEUE_POSITION, [](const Torrent &torrent) -> QVariant
+        {
+            const int position = torrent.queuePosition();
+            return (position < 0) ? 0 : (position + 1);
+        }},
+        {KEY_TORRENT_SEEDS, [](const Torrent &torrent) -> QVariant { return torrent.seedsCount(); }},
+        {KEY_TORRENT_NUM_COMPLETE, [](const Torrent &torrent) -> QVariant { return torrent.totalSeedsCount(); }},
+        {KEY_TORRENT_LEECHS, [](const Torrent &torrent) -> QVariant { return torrent.leechsCount(); }},
+        {KEY_TORRENT_NUM_INCOMPLETE, [](const Torrent &torrent) -> QVariant { return torrent.totalLeechersCount(); }},
+
+        {KEY_TORRENT_STATE, [](const Torrent &torrent) -> QVariant { return torrentStateToString(torrent.state()); }},
+        {KEY_TORRENT_ETA, [](const Torrent &torrent) -> QVariant { return torrent.eta(); }},
+        {KEY_TORRENT_SEQUENTIAL_DOWNLOAD, [](const Torrent &torrent) -> QVariant { return torrent.isSequentialDownload(); }},
+        {KEY_TORRENT_FIRST_LAST_PIECE_PRIO, [](const Torrent &torrent) -> QVariant { return torrent.hasFirstLastPiecePriority(); }},
+
+        {KEY_TORRENT_CATEGORY, [](const Torrent &torrent) -> QVariant { return torrent.category(); }},
+        {KEY_TORRENT_TAGS, [](const Torrent &torrent) -> QVariant { return torrent.tags().join(QLatin1String(", ")); }},
+        {KEY_TORRENT_SUPER_SEEDING, [](const Torrent &torrent) -> QVariant { return torrent.superSeeding(); }},
+        {KEY_TORRENT_FORCE_START, [](const Torrent &torrent) -> QVariant { return torrent.isForced(); }},
+        {KEY_TORRENT_SAVE_PATH, [](const Torrent &torrent) -> QVariant { return Utils::Fs::toNativePath(torrent.savePath()); }},
+        {KEY_TORRENT_CONTENT_PATH, [](const Torrent &torrent) -> QVariant { return Utils::Fs::toNativePath(torrent.contentPath()); }},
+        {KEY_TORRENT_ADDED_ON, [](const Torrent &torrent) -> QVariant { return torrent.addedTime().toSecsSinceEpoch(); }},
+        {KEY_TORRENT_COMPLETION_ON, [](const Torrent &torrent) -> QVariant { return torrent.completedTime().toSecsSinceEpoch(); }},
+        {KEY_TORRENT_TRACKER, [](const Torrent &torrent) -> QVariant { return torrent.currentTracker(); }},
+        {KEY_TORRENT_TRACKERS_COUNT, [](const Torrent &torrent) -> QVariant { return torrent.trackers().size(); }},
+        {KEY_TORRENT_DL_LIMIT, [](const Torrent &torrent) -> QVariant { return torrent.downloadLimit(); }},
+        {KEY_TORRENT_UP_LIMIT, [](const Torrent &torrent) -> QVariant { return torrent.uploadLimit(); }},
+        {KEY_TORRENT_AMOUNT_DOWNLOADED, [](const Torrent &torrent) -> QVariant { return torrent.totalDownload(); }},
+        {KEY_TORRENT_AMOUNT_UPLOADED, [](const Torrent &torrent) -> QVariant { return torrent.totalUpload(); }},
+        {KEY_TORRENT_AMOUNT_DOWNLOADED_SESSION, [](const Torrent &torrent) -> QVariant { return torrent.totalPayloadDownload(); }},
+        {KEY_TORRENT_AMOUNT_UPLOADED_SESSION, [](const Torrent &torrent) -> QVariant { return torrent.totalPayloadUpload(); }},
+        {KEY_TORRENT_AMOUNT_LEFT, [](const Torrent &torrent) -> QVariant { return torrent.remainingSize(); }},
+        {KEY_TORRENT_AMOUNT_COMPLETED, [](const Torrent &torrent) -> QVariant { return torrent.completedSize(); }},
+        {KEY_TORRENT_MAX_RATIO, [](const Torrent &torrent) -> QVariant { return torrent.maxRatio(); }},
+        {KEY_TORRENT_MAX_SEEDING_TIME, [](const Torrent &torrent) -> QVariant { return torrent.maxSeedingTime(); }},
+        {KEY_TORRENT_RATIO, [](const Torrent &torrent) -> QVariant
+        {
+            const qreal ratio = torrent.realRatio();
+            return (ratio > BitTorrent::Torrent::MAX_RATIO) ? -1 : ratio;
+        }},
+        {KEY_TORRENT_RATIO_LIMIT, [](const Torrent &torrent) -> QVariant { return torrent.ratioLimit(); }},
+        {KEY_TORRENT_SEEDING_TIME_LIMIT, [](const Torrent &torrent) -> QVariant { return torrent.seedingTimeLimit(); }},
+        {KEY_TORRENT_LAST_SEEN_COMPLETE_TIME, [](const Torrent &torrent) -> QVariant { return torrent.lastSeenComplete().toSecsSinceEpoch(); }},
+        {KEY_TORRENT_AUTO_TORRENT_MANAGEMENT, [](const Torrent &torrent) -> QVariant { return torrent.isAutoTMMEnabled(); }},
+        {KEY_TORRENT_TIME_ACTIVE, [](const Torrent &torrent) -> QVariant { return torrent.activeTime(); }},
+        {KEY_TORRENT_SEEDING_TIME, [](const Torrent &torrent) -> QVariant { return torrent.seedingTime(); }},
+        {KEY_TORRENT_LAST_ACTIVITY_TIME, [](const Torrent &torrent) -> QVariant
+        {
+            return (QDateTime::currentDateTime().toSecsSinceEpoch() - torrent.timeSinceActivity());
+        }},
+        {KEY_TORRENT_AVAILABILITY, [](const Torrent &torrent) -> QVariant { return torrent.distributedCopies(); }},
 
-    return {
-        {KEY_TORRENT_ID, torrent.id().toString()},
-        {KEY_TORRENT_INFOHASHV1, torrent.infoHash().v1().toString()},
-        {KEY_TORRENT_INFOHASHV2, torrent.infoHash().v2().toString()},
-        {KEY_TORRENT_NAME, torrent.name()},
-        {KEY_TORRENT_MAGNET_URI, torrent.createMagnetURI()},
-        {KEY_TORRENT_SIZE, torrent.wantedSize()},
-        {KEY_TORRENT_PROGRESS, torrent.progress()},
-        {KEY_TORRENT_DLSPEED, torrent.downloadPayloadRate()},
-        {KEY_TORRENT_UPSPEED, torrent.uploadPayloadRate()},
-        {KEY_TORRENT_QUEUE_POSITION, adjustQueuePosition(torrent.queuePosition())},
-        {KEY_TORRENT_SEEDS, torrent.seedsCount()},
-        {KEY_TORRENT_NUM_COMPLETE, torrent.totalSeedsCount()},
-        {KEY_TORRENT_LEECHS, torrent.leechsCount()},
-        {KEY_TORRENT_NUM_INCOMPLETE, torrent.totalLeechersCount()},
-
-        {KEY_TORRENT_STATE, torrentStateToString(torrent.state())},
-        {KEY_TORRENT_ETA, torrent.eta()},
-        {KEY_TORRENT_SEQUENTIAL_DOWNLOAD, torrent.isSequentialDownload()},
-        {KEY_TORRENT_FIRST_LAST_PIECE_PRIO, torrent.hasFirstLastPiecePriority()},
-
-        {KEY_TORRENT_CATEGORY, torrent.category()},
-        {KEY_TORRENT_TAGS, torrent.tags().join(QLatin1String(", "))},
-        {KEY_TORRENT_SUPER_SEEDING, torrent.superSeeding()},
-        {KEY_TORRENT_FORCE_START, torrent.isForced()},
-        {KEY_TORRENT_SAVE_PATH, Utils::Fs::toNativePath(torrent.savePath())},
-        {KEY_TORRENT_CONTENT_PATH, Utils::Fs::toNativePath(torrent.contentPath())},
-        {KEY_TORRENT_ADDED_ON, torrent.addedTime().toSecsSinceEpoch()},
-        {KEY_TORRENT_COMPLETION_ON, torrent.completedTime().toSecsSinceEpoch()},
-        {KEY_TORRENT_TRACKER, torrent.currentTracker()},
-        {KEY_TORRENT_TRACKERS_COUNT, torrent.trackers().size()},
-        {KEY_TORRENT_DL_LIMIT, torrent.downloadLimit()},
-        {KEY_TORRENT_UP_LIMIT, torrent.uploadLimit()},
-        {KEY_TORRENT_AMOUNT_DOWNLOADED, torrent.totalDownload()},
-        {KEY_TORRENT_AMOUNT_UPLOADED, torrent.totalUpload()},
-        {KEY_TORRENT_AMOUNT_DOWNLOADED_SESSION, torrent.totalPayloadDownload()},
-        {KEY_TORRENT_AMOUNT_UPLOADED_SESSION, torrent.totalPayloadUpload()},
-        {KEY_TORRENT_AMOUNT_LEFT, torrent.remainingSize()},
-        {KEY_TORRENT_AMOUNT_COMPLETED, torrent.completedSize()},
-        {KEY_TORRENT_MAX_RATIO, torrent.maxRatio()},
-        {KEY_TORRENT_MAX_SEEDING_TIME, torrent.maxSeedingTime()},
-        {KEY_TORRENT_RATIO, adjustRatio(torrent.realRatio())},
-        {KEY_TORRENT_RATIO_LIMIT, torrent.ratioLimit()},
-        {KEY_TORRENT_SEEDING_TIME_LIMIT, torrent.seedingTimeLimit()},
-        {KEY_TORRENT_LAST_SEEN_COMPLETE_TIME, torrent.lastSeenComplete().toSecsSinceEpoch()},
-        {KEY_TORRENT_AUTO_TORRENT_MANAGEMENT, torrent.isAutoTMMEnabled()},
-        {KEY_TORRENT_TIME_ACTIVE, torrent.activeTime()},
-        {KEY_TORRENT_SEEDING_TIME, torrent.seedingTime()},
-        {KEY_TORRENT_LAST_ACTIVITY_TIME, (QDateTime::currentDateTime().toSecsSinceEpoch() - torrent.timeSinceActivity())},
-        {KEY_TORRENT_AVAILABILITY, torrent.distributedCopies()},
-
-        {KEY_TORRENT_TOTAL_SIZE, torrent.totalSize()}
+        {KEY_TORRENT_TOTAL_SIZE, [](const Torrent &torrent) -> QVariant { return torrent.totalSize(); }}
     };
+
+    const QHash<QString, TorrentFieldGetter> &torrentFieldGetters()
+    {
+        static const QHash<QString, TorrentFieldGetter> getters = []()
+        {
+            QHash<QString, TorrentFieldGetter> result;
+            for (const TorrentField &field : TORRENT_FIELDS)
+                result.insert(QString::fromLatin1(field.key), field.getter);
+            return result;
+        }();
+        return getters;
+    }
+}
+
+std::optional<TorrentKeySet> parseTorrentKeys(const QString &keys)
+{
+    const QHash<QString, TorrentFieldGetter> &getters = torrentFieldGetters();
+
+    TorrentKeySet result;
+    for (const QString &key : asConst(keys.split(QLatin1Char('|'), Qt::SkipEmptyParts)))
+    {
+        if (!getters.contains(key))
+            return std::nullopt;
+        result.insert(key);
+    }
+
+    return result;
+}
+
+TorrentFieldGetter torrentFieldGetter(const QString &key)
+{
+    return torrentFieldGetters().value(key);
+}
+
+QVariantMap serialize(const BitTorrent::Torrent &torrent, const TorrentKeySet &keys)
+{
+    QVariantMap result;
+
+    if (keys.isEmpty())
+    {
+        for (const TorrentField &field : TORRENT_FIELDS)
+            result.insert(QString::fromLatin1(field.key), field.getter(torrent));
+    }
+    else
+    {
+        // Getters of the fields that aren't requested are never called
+        const QHash<QString, TorrentFieldGetter> &getters = torrentFieldGetters();
+        for (const QString &key : keys)
+        {
+            const TorrentFieldGetter getter = getters.value(key);
+            if (getter)
+                result.insert(key, getter(torrent));
+        }
+    }
+
+    return result;
 }
@@ -28,11 +28,15 @@
 
 #pragma once
 
+#include <optional>
+
+#include <QSet>
 #include <QVariant>
 
 namespace BitTorrent
 {
     class Torrent;
+    enum class TorrentState;
 }
 
 // Torrent keys
@@ -86,4 +90,13 @@ inline const char KEY_TORRENT_TIME_ACTIVE[] = "time_active";
 inline const char KEY_TORRENT_SEEDING_TIME[] = "seeding_time";
 inline const char KEY_TORRENT_AVAILABILITY[] = "availability";
 
-QVariantMap serialize(const BitTorrent::Torrent &torrent);
+// Set of torrent keys to serialize, empty set means all the keys
+using TorrentKeySet = QSet<QString>;
+using TorrentFieldGetter = QVariant (*)(const BitTorrent::Torrent &torrent);
+
+QString torrentStateToString(BitTorrent::TorrentState state);
+// Parses the list of keys separated by '|', returns nullopt if it contains unknown key
+std::optional<TorrentKeySet> parseTorrentKeys(const QString &keys);
+// Returns the getter used to serialize the given key or nullptr if the key is unknown
+TorrentFieldGetter torrentFieldGetter(const QString &key);
+QVariantMap serialize(const BitTorrent::Torrent &torrent, const TorrentKeySet &keys = {});
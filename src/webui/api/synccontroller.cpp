@@ -267,6 +267,11 @@ namespace
                         // new list item found - append it to syncData
                         syncData[i.key()] = i.value();
                     }
+                    else if (prevData[i.key()] == i.value())
+                    {
+                        // unchanged (usually shared) list found - just remove it from prevData
+                        prevData.remove(i.key());
+                    }
                     else
                     {
                         QVariantList list;
@@ -377,6 +382,27 @@ SyncController::SyncController(ISessionManager *sessionManager, QObject *parent)
     m_freeDiskSpaceThread->start();
     invokeChecker();
     m_freeDiskSpaceElapsedTimer.start();
+
+    const auto *session = BitTorrent::Session::instance();
+    connect(session, &BitTorrent::Session::torrentLoaded, this, &SyncController::onTorrentLoaded);
+    connect(session, &BitTorrent::Session::torrentAboutToBeRemoved, this, &SyncController::onTorrentAboutToBeRemoved);
+    connect(session, &BitTorrent::Session::torrentsUpdated, this, &SyncController::onTorrentsUpdated);
+    connect(session, &BitTorrent::Session::torrentCategoryChanged, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentChanged, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentFinished, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentFinishedChecking, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentMetadataReceived, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentPaused, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentResumed, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentSavePathChanged, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentSavingModeChanged, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentTagAdded, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentTagRemoved, this, &SyncController::onTorrentChanged);
+    connect(session, &BitTorrent::Session::trackerEntriesUpdated, this, &SyncController::onTrackerEntriesUpdated);
+    connect(session, &BitTorrent::Session::trackersAdded, this, &SyncController::onTrackersChanged);
+    connect(session, &BitTorrent::Session::trackersRemoved, this, &SyncController::onTrackersChanged);
+    connect(session, &BitTorrent::Session::trackersChanged, this, &SyncController::onTrackersChanged);
+    connect(session, &BitTorrent::Session::globalShareLimitsChanged, this, &SyncController::onGlobalShareLimitsChanged);
 }
 
 SyncController::~SyncController()
@@ -447,53 +473,17 @@ SyncController::~SyncController()
 //  - "free_space_on_disk": Free space on the default save path
 // GET param:
 //   - rid (int): last response id
+//   - fields (string): names of torrent keys to return separated by | (all keys if not specified)
 void SyncController::maindataAction()
 {
+    const std::optional<TorrentKeySet> torrentKeys = parseTorrentKeys(params()["fields"]);
+    if (!torrentKeys)
+        throw APIError(APIErrorType::BadParams, tr("'fields' parameter is invalid"));
+
     const auto *session = BitTorrent::Session::instance();
 
     QVariantMap data;
 
-    QVariantMap lastResponse = sessionManager()->session()->getData(QLatin1String("syncMainDataLastResponse")).toMap();
-    QVariantMap lastAcceptedResponse = sessionManager()->session()->getData(QLatin1String("syncMainDataLastAcceptedResponse")).toMap();
-
-    QVariantHash torrents;
-    QHash<QString, QStringList> trackers;
-    for (const BitTorrent::Torrent *torrent : asConst(session->torrents()))
-    {
-        const BitTorrent::TorrentID torrentID = torrent->id();
-
-        QVariantMap map = serialize(*torrent);
-        map.remove(KEY_TORRENT_ID);
-
-        // Calculated last activity time can differ from actual value by up to 10 seconds (this is a libtorrent issue).
-        // So we don't need unnecessary updates of last activity time in response.
-        const auto iterTorrents = lastResponse.find("torrents");
-        if (iterTorrents != lastResponse.end())
-        {
-            const QVariantHash lastResponseTorrents = iterTorrents->toHash();
-            const auto iterID = lastResponseTorrents.find(torrentID.toString());
-
-            if (iterID != lastResponseTorrents.end())
-            {
-                const QVariantMap torrentData = iterID->toMap();
-                const auto iterLastActivity = torrentData.find(KEY_TORRENT_LAST_ACTIVITY_TIME);
-
-                if (iterLastActivity != torrentData.end())
-                {
-                    const int lastValue = iterLastActivity->toInt();
-                    if (qAbs(lastValue - map[KEY_TORRENT_LAST_ACTIVITY_TIME].toInt()) < 15)
-                        map[KEY_TORRENT_LAST_ACTIVITY_TIME] = lastValue;
-                }
-            }
-        }
-
-        for (const BitTorrent::TrackerEntry &tracker : asConst(torrent->trackers()))
-            trackers[tracker.url] << torrentID.toString();
-
-        torrents[torrentID.toString()] = map;
-    }
-    data["torrents"] = torrents;
-
     QVariantHash categories;
     const QStringMap categoriesList = session->categories();
     for (auto it = categoriesList.cbegin(); it != categoriesList.cend(); ++it)
@@ -512,12 +502,7 @@ void SyncController::maindataAction()
         tags << tag;
     data["tags"] = tags;
 
-    QVariantHash trackersHash;
-    for (auto i = trackers.constBegin(); i != trackers.constEnd(); ++i)
-    {
-        trackersHash[i.key()] = i.value();
-    }
-    data["trackers"] = trackersHash;
+    data["trackers"] = trackers();
 
     QVariantMap serverState = getTransferInfo();
     serverState[KEY_TRANSFER_FREESPACEONDISK] = getFreeDiskSpace();
@@ -526,11 +511,264 @@ void SyncController::maindataAction()
     serverState[KEY_SYNC_MAINDATA_REFRESH_INTERVAL] = session->refreshInterval();
     data["server_state"] = serverState;
 
+    MainDataClient &client = mainDataClient();
+
     const int acceptedResponseId {params()["rid"].toInt()};
-    setResult(QJsonObject::fromVariantMap(generateSyncData(acceptedResponseId, data, lastAcceptedResponse, lastResponse)));
+    if ((acceptedResponseId > 0) && (acceptedResponseId == client.lastResponseId))
+    {
+        // The client has received the last response so it has the data we sent
+        for (auto it = client.lastTorrents.cbegin(); it != client.lastTorrents.cend(); ++it)
+            client.acceptedTorrents[it.key()] = it.value();
+        for (const QString &hash : asConst(client.lastRemovedTorrents))
+            client.acceptedTorrents.remove(hash);
+        client.acceptedData = client.lastData;
+        client.acceptedChangeID = client.lastChangeID;
+        client.acceptedResponseId = client.lastResponseId;
+    }
+    client.lastTorrents.clear();
+    client.lastRemovedTorrents.clear();
+
+    QVariantMap syncData;
+    // The torrents accepted by client contain other set of keys if the fields were changed
+    const bool fullUpdate = ((acceptedResponseId <= 0) || (acceptedResponseId != client.acceptedResponseId)
+                             || (*torrentKeys != client.torrentKeys));
+    client.torrentKeys = *torrentKeys;
+    if (fullUpdate)
+    {
+        client.acceptedResponseId = 0;
+        client.acceptedChangeID = 0;
+        client.acceptedTorrents.clear();
+        client.acceptedData.clear();
+
+        syncData = data;
+        syncData[KEY_FULL_UPDATE] = true;
+    }
+    else
+    {
+        processMap(client.acceptedData, data, syncData);
+    }
+
+    processTorrents(client, fullUpdate, syncData);
+
+    client.lastResponseId = (client.lastResponseId % 1000000) + 1;  // cycle between 1 and 1000000
+    client.lastChangeID = m_lastChangeID;
+    client.lastData = data;
+    syncData[KEY_RESPONSE_ID] = client.lastResponseId;
+
+    pruneMainDataJournal();
+
+    setResult(QJsonObject::fromVariantMap(syncData));
+}
+
+// Only the torrents changed since the last accepted response are serialized
+// unless full update is requested
+void SyncController::processTorrents(MainDataClient &client, const bool fullUpdate, QVariantMap &syncData) const
+{
+    const auto *session = BitTorrent::Session::instance();
+
+    QVariantMap torrents;
+
+    if (fullUpdate)
+    {
+        for (const BitTorrent::Torrent *torrent : asConst(session->torrents()))
+        {
+            const QString hash = torrent->id().toString();
+
+            QVariantMap map = serialize(*torrent, client.torrentKeys);
+            map.remove(KEY_TORRENT_ID);
+
+            torrents[hash] = map;
+            client.lastTorrents[hash] = map;
+        }
+
+        syncData["torrents"] = torrents;
+        return;
+    }
+
+    QVariantList removedTorrents;
+    for (auto iter = m_removedTorrents.upper_bound(client.acceptedChangeID); iter != m_removedTorrents.cend(); ++iter)
+    {
+        const BitTorrent::TorrentID &torrentID = iter->second;
+        const QString hash = torrentID.toString();
+        if (client.acceptedTorrents.contains(hash) && !client.lastRemovedTorrents.contains(hash)
+                && !session->findTorrent(torrentID))
+        {
+            removedTorrents << hash;
+            client.lastRemovedTorrents.insert(hash);
+        }
+    }
+
+    for (auto iter = m_changedTorrents.upper_bound(client.acceptedChangeID); iter != m_changedTorrents.cend(); ++iter)
+    {
+        const BitTorrent::Torrent *torrent = session->findTorrent(iter->second);
+        if (!torrent)
+            continue;
+
+        const QString hash = iter->second.toString();
+
+        QVariantMap map = serialize(*torrent, client.torrentKeys);
+        map.remove(KEY_TORRENT_ID);
+
+        const auto iterAccepted = client.acceptedTorrents.constFind(hash);
+        if (iterAccepted == client.acceptedTorrents.cend())
+        {
+            torrents[hash] = map;
+        }
+        else
+        {
+            // Calculated last activity time can differ from actual value by up to 10 seconds (this is a libtorrent issue).
+            // So we don't need unnecessary updates of last activity time in response.
+            const auto iterLastActivity = iterAccepted->find(KEY_TORRENT_LAST_ACTIVITY_TIME);
+            if (iterLastActivity != iterAccepted->end())
+            {
+                const int lastValue = iterLastActivity->toInt();
+                if (qAbs(lastValue - map[KEY_TORRENT_LAST_ACTIVITY_TIME].toInt()) < 15)
+                    map[KEY_TORRENT_LAST_ACTIVITY_TIME] = lastValue;
+            }
+
+            QVariantMap changes;
+            processMap(*iterAccepted, map, changes);
+            if (!changes.isEmpty())
+                torrents[hash] = changes;
+        }
+
+        client.lastTorrents[hash] = map;
+    }
+
+    if (!torrents.isEmpty())
+        syncData["torrents"] = torrents;
+    if (!removedTorrents.isEmpty())
+        syncData[QString::fromLatin1("torrents") + KEY_SUFFIX_REMOVED] = removedTorrents;
+}
+
+SyncController::MainDataClient &SyncController::mainDataClient()
+{
+    // Forget the clients which haven't requested data for too long (most likely their sessions are expired)
+    const qint64 clientTimeout = Preferences::instance()->getWebUISessionTimeout() * 1000LL;
+    for (auto iter = m_mainDataClients.begin(); iter != m_mainDataClients.end();)
+    {
+        if (iter->lastRequestTimer.hasExpired(clientTimeout))
+            iter = m_mainDataClients.erase(iter);
+        else
+            ++iter;
+    }
+
+    MainDataClient &client = m_mainDataClients[sessionManager()->session()->id()];
+    client.lastRequestTimer.start();
+    return client;
+}
+
+void SyncController::pruneMainDataJournal()
+{
+    // Removed torrents are kept in journal until all the clients get informed about them
+    qint64 minChangeID = m_lastChangeID;
+    for (const MainDataClient &client : asConst(m_mainDataClients))
+    {
+        const qint64 clientChangeID = (client.acceptedResponseId > 0) ? client.acceptedChangeID : client.lastChangeID;
+        minChangeID = std::min(minChangeID, clientChangeID);
+    }
+
+    m_removedTorrents.erase(m_removedTorrents.begin(), m_removedTorrents.upper_bound(minChangeID));
+}
+
+void SyncController::journalTorrentChange(const BitTorrent::TorrentID &torrentID)
+{
+    const qint64 changeID = ++m_lastChangeID;
+
+    const auto iter = m_torrentChangeIDs.find(torrentID);
+    if (iter != m_torrentChangeIDs.end())
+    {
+        m_changedTorrents.erase(iter.value());
+        iter.value() = changeID;
+    }
+    else
+    {
+        m_torrentChangeIDs.insert(torrentID, changeID);
+    }
+
+    m_changedTorrents.emplace(changeID, torrentID);
+}
+
+void SyncController::onTorrentLoaded(BitTorrent::Torrent *torrent)
+{
+    journalTorrentChange(torrent->id());
+    m_trackersChanged = true;
+}
+
+void SyncController::onTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent)
+{
+    const BitTorrent::TorrentID torrentID = torrent->id();
+
+    const auto iter = m_torrentChangeIDs.find(torrentID);
+    if (iter != m_torrentChangeIDs.end())
+    {
+        m_changedTorrents.erase(iter.value());
+        m_torrentChangeIDs.erase(iter);
+    }
+
+    const qint64 changeID = ++m_lastChangeID;
+    if (!m_mainDataClients.isEmpty())
+        m_removedTorrents.emplace(changeID, torrentID);
+
+    m_trackersChanged = true;
+}
+
+void SyncController::onTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents)
+{
+    for (const BitTorrent::Torrent *torrent : torrents)
+        journalTorrentChange(torrent->id());
+}
+
+void SyncController::onTorrentChanged(BitTorrent::Torrent *torrent)
+{
+    journalTorrentChange(torrent->id());
+}
+
+void SyncController::onTrackerEntriesUpdated(const QHash<BitTorrent::Torrent *, QSet<QString>> &updateInfos)
+{
+    for (auto iter = updateInfos.cbegin(); iter != updateInfos.cend(); ++iter)
+        journalTorrentChange(iter.key()->id());
+}
+
+void SyncController::onTrackersChanged(BitTorrent::Torrent *torrent)
+{
+    journalTorrentChange(torrent->id());
+    m_trackersChanged = true;
+}
+
+void SyncController::onGlobalShareLimitsChanged()
+{
+    // "max_ratio" and "max_seeding_time" of the torrents using global limits are taken from them
+    for (const BitTorrent::Torrent *torrent : asConst(BitTorrent::Session::instance()->torrents()))
+    {
+        if ((torrent->ratioLimit() == BitTorrent::Torrent::USE_GLOBAL_RATIO)
+            || (torrent->seedingTimeLimit() == BitTorrent::Torrent::USE_GLOBAL_SEEDING_TIME))
+        {
+            journalTorrentChange(torrent->id());
+        }
+    }
+}
+
+QVariantHash SyncController::trackers()
+{
+    if (m_trackersChanged)
+    {
+        QHash<QString, QStringList> trackers;
+        for (const BitTorrent::Torrent *torrent : asConst(BitTorrent::Session::instance()->torrents()))
+        {
+            const QString hash = torrent->id().toString();
+            for (const BitTorrent::TrackerEntry &tracker : asConst(torrent->trackers()))
+                trackers[tracker.url] << hash;
+        }
+
+        m_trackers.clear();
+        for (auto i = trackers.constBegin(); i != trackers.constEnd(); ++i)
+            m_trackers[i.key()] = i.value();
+
+        m_trackersChanged = false;
+    }
 
-    sessionManager()->session()->setData(QLatin1String("syncMainDataLastResponse"), lastResponse);
-    sessionManager()->session()->setData(QLatin1String("syncMainDataLastAcceptedResponse"), lastAcceptedResponse);
+    return m_trackers;
 }
 
 // GET param:
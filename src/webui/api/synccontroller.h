@@ -28,9 +28,17 @@
 
 #pragma once
 
+#include <map>
+
 #include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QVariantMap>
+#include <QVector>
 
+#include "base/bittorrent/infohash.h"
 #include "apicontroller.h"
+#include "serialize/serialize_torrent.h"
 
 struct ISessionManager;
 
@@ -38,6 +46,11 @@ class QThread;
 
 class FreeDiskSpaceChecker;
 
+namespace BitTorrent
+{
+    class Torrent;
+}
+
 class SyncController : public APIController
 {
     Q_OBJECT
@@ -55,11 +68,55 @@ private slots:
     void freeDiskSpaceSizeUpdated(qint64 freeSpaceSize);
 
 private:
+    // State of main data synchronization with particular client
+    struct MainDataClient
+    {
+        QElapsedTimer lastRequestTimer;
+        TorrentKeySet torrentKeys;
+
+        int acceptedResponseId = 0;
+        qint64 acceptedChangeID = 0;
+        QHash<QString, QVariantMap> acceptedTorrents;
+        QVariantMap acceptedData;
+
+        int lastResponseId = 0;
+        qint64 lastChangeID = 0;
+        QHash<QString, QVariantMap> lastTorrents;
+        QSet<QString> lastRemovedTorrents;
+        QVariantMap lastData;
+    };
+
     qint64 getFreeDiskSpace();
     void invokeChecker() const;
 
+    void onTorrentLoaded(BitTorrent::Torrent *torrent);
+    void onTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent);
+    void onTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents);
+    void onTorrentChanged(BitTorrent::Torrent *torrent);
+    void onTrackerEntriesUpdated(const QHash<BitTorrent::Torrent *, QSet<QString>> &updateInfos);
+    void onTrackersChanged(BitTorrent::Torrent *torrent);
+    void onGlobalShareLimitsChanged();
+    void journalTorrentChange(const BitTorrent::TorrentID &torrentID);
+    void pruneMainDataJournal();
+
+    MainDataClient &mainDataClient();
+    void processTorrents(MainDataClient &client, bool fullUpdate, QVariantMap &syncData) const;
+    QVariantHash trackers();
+
     qint64 m_freeDiskSpace = 0;
     FreeDiskSpaceChecker *m_freeDiskSpaceChecker = nullptr;
     QThread *m_freeDiskSpaceThread = nullptr;
     QElapsedTimer m_freeDiskSpaceElapsedTimer;
+
+    // Journal of torrent changes. Each torrent has single entry at the ID of its latest change
+    // so the torrents changed since some point are found without visiting the rest of them.
+    qint64 m_lastChangeID = 0;
+    std::map<qint64, BitTorrent::TorrentID> m_changedTorrents;
+    QHash<BitTorrent::TorrentID, qint64> m_torrentChangeIDs;
+    std::map<qint64, BitTorrent::TorrentID> m_removedTorrents;
+
+    QHash<QString, MainDataClient> m_mainDataClients;
+
+    QVariantHash m_trackers;
+    bool m_trackersChanged = true;
 };
@@ -56,6 +56,7 @@
 #include "base/utils/string.h"
 #include "apierror.h"
 #include "serialize/serialize_torrent.h"
+#include "torrentssnapshot.h"
 
 // Tracker keys
 const char KEY_TRACKER_URL[] = "url";
@@ -222,6 +223,12 @@ namespace
     }
 }
 
+TorrentsController::TorrentsController(ISessionManager *sessionManager, QObject *parent)
+    : APIController(sessionManager, parent)
+    , m_torrentsSnapshot(new TorrentsSnapshot(this))
+{
+}
+
 // Returns all the torrents in JSON format.
 // The return value is a JSON-formatted list of dictionaries.
 // The dictionary keys are:
@@ -252,6 +259,7 @@ namespace
 //   - reverse (bool): enable reverse sorting
 //   - limit (int): set limit number of torrents returned (if greater than 0, otherwise - unlimited)
 //   - offset (int): set offset (if less than 0 - offset from end)
+//   - fields (string): names of keys to return separated by | (all keys if not specified)
 void TorrentsController::infoAction()
 {
     const QString filter {params()["filter"]};
@@ -262,79 +270,45 @@ void TorrentsController::infoAction()
     int limit {params()["limit"].toInt()};
     int offset {params()["offset"].toInt()};
     const QStringList hashes {params()["hashes"].split('|', Qt::SkipEmptyParts)};
+    const std::optional<TorrentKeySet> fields = parseTorrentKeys(params()["fields"]);
+    if (!fields)
+        throw APIError(APIErrorType::BadParams, tr("'fields' parameter is invalid"));
 
     TorrentIDSet idSet;
     for (const QString &hash : hashes)
         idSet.insert(BitTorrent::TorrentID::fromString(hash));
 
-    const TorrentFilter torrentFilter(filter, (hashes.isEmpty() ? TorrentFilter::AnyID : idSet), category, tag);
-    QVariantList torrentList;
-    for (const BitTorrent::Torrent *torrent : asConst(BitTorrent::Session::instance()->torrents()))
-    {
-        if (torrentFilter.match(torrent))
-            torrentList.append(serialize(*torrent));
-    }
-
-    if (torrentList.isEmpty())
+    const TorrentIDSet &torrentIDs = (hashes.isEmpty() ? TorrentFilter::AnyID : idSet);
+    const TorrentFilter torrentFilter(filter, torrentIDs, category, tag);
+    QVector<int> rows = m_torrentsSnapshot->findRows(torrentFilter);
+    if (rows.isEmpty())
     {
         setResult(QJsonArray {});
         return;
     }
 
-    if (!sortedColumn.isEmpty())
-    {
-        if (!torrentList[0].toMap().contains(sortedColumn))
-            throw APIError(APIErrorType::BadParams, tr("'sort' parameter is invalid"));
-
-        const auto lessThan = [](const QVariant &left, const QVariant &right) -> bool
-        {
-            Q_ASSERT(left.type() == right.type());
-
-            switch (static_cast<QMetaType::Type>(left.type()))
-            {
-            case QMetaType::Bool:
-                return left.value<bool>() < right.value<bool>();
-            case QMetaType::Double:
-                return left.value<double>() < right.value<double>();
-            case QMetaType::Float:
-                return left.value<float>() < right.value<float>();
-            case QMetaType::Int:
-                return left.value<int>() < right.value<int>();
-            case QMetaType::LongLong:
-                return left.value<qlonglong>() < right.value<qlonglong>();
-            case QMetaType::QString:
-                return left.value<QString>() < right.value<QString>();
-            default:
-                qWarning("Unhandled QVariant comparison, type: %d, name: %s", left.type()
-                    , QMetaType::typeName(left.type()));
-                break;
-            }
-            return false;
-        };
-
-        std::sort(torrentList.begin(), torrentList.end()
-            , [reverse, &sortedColumn, &lessThan](const QVariant &torrent1, const QVariant &torrent2)
-        {
-            const QVariant value1 {torrent1.toMap().value(sortedColumn)};
-            const QVariant value2 {torrent2.toMap().value(sortedColumn)};
-            return reverse ? lessThan(value2, value1) : lessThan(value1, value2);
-        });
-    }
+    if (!sortedColumn.isEmpty() && !m_torrentsSnapshot->isSortable(sortedColumn))
+        throw APIError(APIErrorType::BadParams, tr("'sort' parameter is invalid"));
 
-    const int size = torrentList.size();
+    const int size = rows.size();
     // normalize offset
     if (offset < 0)
         offset = size + offset;
     if ((offset >= size) || (offset < 0))
         offset = 0;
     // normalize limit
-    if (limit <= 0)
-        limit = -1; // unlimited
+    if ((limit <= 0) || (limit > (size - offset)))
+        limit = size - offset;
+
+    // only the rows of requested page need to be sorted
+    if (!sortedColumn.isEmpty())
+        m_torrentsSnapshot->sortRows(rows, sortedColumn, reverse, (offset + limit));
 
-    if ((limit > 0) || (offset > 0))
-        torrentList = torrentList.mid(offset, limit);
+    QJsonArray torrentList;
+    for (int i = offset; i < (offset + limit); ++i)
+        torrentList.append(QJsonObject::fromVariantMap(serialize(*m_torrentsSnapshot->torrent(rows[i]), *fields)));
 
-    setResult(QJsonArray::fromVariantList(torrentList));
+    setResult(torrentList);
 }
 
 // Returns the properties for a torrent in JSON format.
@@ -30,13 +30,15 @@
 
 #include "apicontroller.h"
 
+class TorrentsSnapshot;
+
 class TorrentsController : public APIController
 {
     Q_OBJECT
     Q_DISABLE_COPY_MOVE(TorrentsController)
 
 public:
-    using APIController::APIController;
+    explicit TorrentsController(ISessionManager *sessionManager, QObject *parent = nullptr);
 
 private slots:
     void infoAction();
@@ -85,4 +87,7 @@ private slots:
     void toggleFirstLastPiecePrioAction();
     void renameFileAction();
     void renameFolderAction();
+
+private:
+    TorrentsSnapshot *m_torrentsSnapshot = nullptr;
 };
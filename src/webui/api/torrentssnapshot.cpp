@@ -0,0 +1,283 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "torrentssnapshot.h"
+
+#include <algorithm>
+
+#include <QMetaType>
+#include <QVariant>
+
+#include "base/bittorrent/session.h"
+#include "base/bittorrent/torrent.h"
+#include "base/global.h"
+#include "base/torrentfilterindex.h"
+#include "serialize/serialize_torrent.h"
+
+class TorrentsSnapshot::Column final
+{
+public:
+    explicit Column(const TorrentFieldGetter getter)
+        : m_getter {getter}
+    {
+    }
+
+    void refresh(const QVector<int> &rows, const QVector<BitTorrent::Torrent *> &torrents
+                 , const QVector<quint64> &rowRevisions)
+    {
+        // new values get zero revision which never matches the revision of any row
+        m_revisions.resize(torrents.size());
+        m_intValues.resize(torrents.size());
+        m_realValues.resize(torrents.size());
+        m_stringValues.resize(torrents.size());
+
+        for (const int row : rows)
+        {
+            if (m_revisions[row] == rowRevisions[row])
+                continue;
+
+            // The value is stored in the array matching the type returned by serializer
+            const QVariant value = m_getter(*torrents[row]);
+            m_valueType = value.userType();
+            switch (m_valueType)
+            {
+            case QMetaType::QString:
+                m_stringValues[row] = value.toString();
+                break;
+            case QMetaType::Double:
+                m_realValues[row] = value.toDouble();
+                break;
+            default:
+                m_intValues[row] = value.toLongLong();
+                break;
+            }
+
+            m_revisions[row] = rowRevisions[row];
+        }
+    }
+
+    void truncate(const int size)
+    {
+        if (m_revisions.size() > size)
+        {
+            m_revisions.resize(size);
+            m_intValues.resize(size);
+            m_realValues.resize(size);
+            m_stringValues.resize(size);
+        }
+    }
+
+    void sortRows(QVector<int> &rows, const bool reverse, const int count) const
+    {
+        switch (m_valueType)
+        {
+        case QMetaType::QString:
+            sortRows(m_stringValues, rows, reverse, count);
+            break;
+        case QMetaType::Double:
+            sortRows(m_realValues, rows, reverse, count);
+            break;
+        default:
+            sortRows(m_intValues, rows, reverse, count);
+            break;
+        }
+    }
+
+private:
+    template <typename T>
+    static void sortRows(const QVector<T> &values, QVector<int> &rows, const bool reverse, const int count)
+    {
+        // Rows having equal values are ordered by their indexes
+        // so the pages of the same list do not overlap
+        const auto lessThan = [&values, reverse](const int left, const int right) -> bool
+        {
+            const T &leftValue = values[left];
+            const T &rightValue = values[right];
+            if (leftValue < rightValue)
+                return !reverse;
+            if (rightValue < leftValue)
+                return reverse;
+            return (left < right);
+        };
+
+        if (count < rows.size())
+            std::partial_sort(rows.begin(), (rows.begin() + count), rows.end(), lessThan);
+        else
+            std::sort(rows.begin(), rows.end(), lessThan);
+    }
+
+    const TorrentFieldGetter m_getter;
+    int m_valueType = QMetaType::UnknownType;
+    QVector<quint64> m_revisions;
+    QVector<qint64> m_intValues;
+    QVector<qreal> m_realValues;
+    QVector<QString> m_stringValues;
+};
+
+TorrentsSnapshot::TorrentsSnapshot(QObject *parent)
+    : QObject(parent)
+{
+    const auto *session = BitTorrent::Session::instance();
+    for (BitTorrent::Torrent *torrent : asConst(session->torrents()))
+        onTorrentLoaded(torrent);
+
+    connect(session, &BitTorrent::Session::torrentLoaded, this, &TorrentsSnapshot::onTorrentLoaded);
+    connect(session, &BitTorrent::Session::torrentAboutToBeRemoved, this, &TorrentsSnapshot::onTorrentAboutToBeRemoved);
+    connect(session, &BitTorrent::Session::torrentsUpdated, this, &TorrentsSnapshot::onTorrentsUpdated);
+    connect(session, &BitTorrent::Session::torrentCategoryChanged, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentChanged, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentMetadataReceived, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentSavePathChanged, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentSavingModeChanged, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentTagAdded, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::torrentTagRemoved, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::trackerEntriesUpdated, this, &TorrentsSnapshot::onTrackerEntriesUpdated);
+    connect(session, &BitTorrent::Session::trackersAdded, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::trackersRemoved, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::trackersChanged, this, &TorrentsSnapshot::onTorrentChanged);
+    connect(session, &BitTorrent::Session::globalShareLimitsChanged, this, &TorrentsSnapshot::onGlobalShareLimitsChanged);
+}
+
+TorrentsSnapshot::~TorrentsSnapshot()
+{
+    qDeleteAll(m_columns);
+}
+
+bool TorrentsSnapshot::isSortable(const QString &key) const
+{
+    return (torrentFieldGetter(key) != nullptr);
+}
+
+QVector<int> TorrentsSnapshot::findRows(const TorrentFilter &filter) const
+{
+    const TorrentFilterIndex *filterIndex = BitTorrent::Session::instance()->torrentFilterIndex();
+    const QVector<BitTorrent::Torrent *> torrents = filterIndex->torrents(filter);
+
+    QVector<int> rows;
+    rows.reserve(torrents.size());
+    for (BitTorrent::Torrent *torrent : torrents)
+    {
+        const auto rowIter = m_rows.constFind(torrent);
+        if (rowIter != m_rows.cend())
+            rows.append(rowIter.value());
+    }
+    std::sort(rows.begin(), rows.end());
+
+    return rows;
+}
+
+void TorrentsSnapshot::sortRows(QVector<int> &rows, const QString &key, const bool reverse, const int count)
+{
+    // Columns are created on demand using the same getters as serializer
+    Column *column = m_columns.value(key);
+    if (!column)
+    {
+        const TorrentFieldGetter getter = torrentFieldGetter(key);
+        Q_ASSERT(getter);
+        if (!getter)
+            return;
+
+        column = new Column(getter);
+        m_columns.insert(key, column);
+    }
+
+    column->refresh(rows, m_torrents, m_rowRevisions);
+    column->sortRows(rows, reverse, count);
+}
+
+BitTorrent::Torrent *TorrentsSnapshot::torrent(const int row) const
+{
+    return m_torrents.value(row);
+}
+
+void TorrentsSnapshot::onTorrentLoaded(BitTorrent::Torrent *torrent)
+{
+    if (m_rows.contains(torrent))
+        return;
+
+    m_rows[torrent] = m_torrents.size();
+    m_torrents.append(torrent);
+    m_rowRevisions.append(++m_revision);
+}
+
+void TorrentsSnapshot::onTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent)
+{
+    const auto rowIter = m_rows.find(torrent);
+    if (rowIter == m_rows.end())
+        return;
+
+    // Move the last torrent to the place of removed one to avoid shifting the rest of rows
+    const int row = rowIter.value();
+    const int lastRow = m_torrents.size() - 1;
+    m_rows.erase(rowIter);
+    if (row != lastRow)
+    {
+        BitTorrent::Torrent *lastTorrent = m_torrents[lastRow];
+        m_torrents[row] = lastTorrent;
+        m_rows[lastTorrent] = row;
+        m_rowRevisions[row] = ++m_revision;
+    }
+
+    m_torrents.removeLast();
+    m_rowRevisions.removeLast();
+    for (Column *column : asConst(m_columns))
+        column->truncate(lastRow);
+}
+
+void TorrentsSnapshot::onTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents)
+{
+    ++m_revision;
+    for (BitTorrent::Torrent *torrent : torrents)
+    {
+        const auto rowIter = m_rows.constFind(torrent);
+        if (rowIter != m_rows.constEnd())
+            m_rowRevisions[rowIter.value()] = m_revision;
+    }
+}
+
+void TorrentsSnapshot::onTrackerEntriesUpdated(const QHash<BitTorrent::Torrent *, QSet<QString>> &updateInfos)
+{
+    ++m_revision;
+    for (auto iter = updateInfos.cbegin(); iter != updateInfos.cend(); ++iter)
+    {
+        const auto rowIter = m_rows.constFind(iter.key());
+        if (rowIter != m_rows.constEnd())
+            m_rowRevisions[rowIter.value()] = m_revision;
+    }
+}
+
+void TorrentsSnapshot::onTorrentChanged(BitTorrent::Torrent *torrent)
+{
+    onTorrentsUpdated({torrent});
+}
+
+void TorrentsSnapshot::onGlobalShareLimitsChanged()
+{
+    // "max_ratio" and "max_seeding_time" of the torrents using global limits depend on them
+    m_rowRevisions.fill(++m_revision);
+}
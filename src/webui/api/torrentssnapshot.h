@@ -0,0 +1,81 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  qBittorrent project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QVector>
+
+#include "base/torrentfilter.h"
+
+namespace BitTorrent
+{
+    class Torrent;
+}
+
+// Keeps the values of torrent fields in typed per-field arrays so that
+// the torrent list can be filtered, sorted and paged without serializing
+// the whole list. The values are refreshed lazily, i.e. the field of
+// updated torrent is recalculated only when it is used for sorting.
+class TorrentsSnapshot final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TorrentsSnapshot)
+
+public:
+    explicit TorrentsSnapshot(QObject *parent = nullptr);
+    ~TorrentsSnapshot() override;
+
+    bool isSortable(const QString &key) const;
+
+    QVector<int> findRows(const TorrentFilter &filter) const;
+    // Only first `count` rows are guaranteed to be sorted
+    void sortRows(QVector<int> &rows, const QString &key, bool reverse, int count);
+    BitTorrent::Torrent *torrent(int row) const;
+
+private:
+    class Column;
+
+    void onTorrentLoaded(BitTorrent::Torrent *torrent);
+    void onTorrentAboutToBeRemoved(BitTorrent::Torrent *torrent);
+    void onTorrentsUpdated(const QVector<BitTorrent::Torrent *> &torrents);
+    void onTrackerEntriesUpdated(const QHash<BitTorrent::Torrent *, QSet<QString>> &updateInfos);
+    void onTorrentChanged(BitTorrent::Torrent *torrent);
+    void onGlobalShareLimitsChanged();
+
+    QVector<BitTorrent::Torrent *> m_torrents;
+    QHash<BitTorrent::Torrent *, int> m_rows;
+    // Each row is stamped with the revision of its latest change,
+    // so the columns can detect the values they need to recalculate
+    QVector<quint64> m_rowRevisions;
+    quint64 m_revision = 0;
+
+    QHash<QString, Column *> m_columns;
+};
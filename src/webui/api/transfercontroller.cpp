@@ -28,6 +28,7 @@
 
 #include "transfercontroller.h"
 
+#include <QJsonArray>
 #include <QJsonObject>
 #include <QVector>
 
@@ -46,6 +47,13 @@ const char KEY_TRANSFER_UPRATELIMIT[] = "up_rate_limit";
 const char KEY_TRANSFER_DHT_NODES[] = "dht_nodes";
 const char KEY_TRANSFER_CONNECTION_STATUS[] = "connection_status";
 
+const char KEY_ALERTS_LAST_BATCH_SIZE[] = "last_batch_size";
+const char KEY_ALERTS_LAST_BATCH_HANDLING_TIME[] = "last_batch_handling_time";
+const char KEY_ALERTS_TYPES[] = "types";
+const char KEY_ALERT_TYPE_NAME[] = "name";
+const char KEY_ALERT_TYPE_COUNT[] = "count";
+const char KEY_ALERT_TYPE_HANDLING_TIME[] = "handling_time";
+
 // Returns the global transfer information in JSON format.
 // The return value is a JSON-formatted dictionary.
 // The dictionary keys are:
@@ -129,3 +137,33 @@ void TransferController::banPeersAction()
             BitTorrent::Session::instance()->banIP(addr.ip.toString());
     }
 }
+
+// Returns the statistics of libtorrent alert handling in JSON format.
+// The return value is a JSON-formatted dictionary.
+// The dictionary keys are:
+//   - "last_batch_size": Number of alerts handled at the last time
+//   - "last_batch_handling_time": Time spent handling them (microseconds)
+//   - "types": List of dictionaries describing each handled alert type:
+//       - "name": Alert type name
+//       - "count": Number of alerts handled since the session start
+//       - "handling_time": Total time spent handling them (microseconds)
+void TransferController::alertStatisticsAction()
+{
+    const BitTorrent::AlertStatistics &alertStatistics = BitTorrent::Session::instance()->alertStatistics();
+
+    QJsonArray types;
+    for (const BitTorrent::AlertTypeStatistics &typeStatistics : alertStatistics.types)
+    {
+        types << QJsonObject {
+            {KEY_ALERT_TYPE_NAME, QString::fromLatin1(typeStatistics.name)},
+            {KEY_ALERT_TYPE_COUNT, typeStatistics.count},
+            {KEY_ALERT_TYPE_HANDLING_TIME, (typeStatistics.handlingTime / 1000)}
+        };
+    }
+
+    setResult(QJsonObject {
+        {KEY_ALERTS_LAST_BATCH_SIZE, alertStatistics.lastBatchSize},
+        {KEY_ALERTS_LAST_BATCH_HANDLING_TIME, (alertStatistics.lastBatchHandlingTime / 1000)},
+        {KEY_ALERTS_TYPES, types}
+    });
+}
@@ -47,4 +47,5 @@ private slots:
     void setUploadLimitAction();
     void setDownloadLimitAction();
     void banPeersAction();
+    void alertStatisticsAction();
 };
@@ -30,6 +30,7 @@
 
 #include <algorithm>
 
+#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
@@ -44,6 +45,7 @@
 #include "base/algorithm.h"
 #include "base/global.h"
 #include "base/http/httperror.h"
+#include "base/http/responsegenerator.h"
 #include "base/logger.h"
 #include "base/preferences.h"
 #include "base/types.h"
@@ -91,6 +93,26 @@ namespace
         return ret;
     }
 
+    // [rfc7232] 3.2. If-None-Match
+    bool matchesETag(const QString &ifNoneMatch, const QString &etag)
+    {
+        if (ifNoneMatch.isEmpty())
+            return false;
+
+        for (QStringRef tag : asConst(ifNoneMatch.splitRef(QLatin1Char(','), Qt::SkipEmptyParts)))
+        {
+            tag = tag.trimmed();
+            // weak comparison is used for If-None-Match
+            if (tag.startsWith(QLatin1String("W/")))
+                tag = tag.mid(2);
+
+            if ((tag == QLatin1String("*")) || (tag == etag))
+                return true;
+        }
+
+        return false;
+    }
+
     QUrl urlFromHostHeader(const QString &hostHeader)
     {
         if (!hostHeader.contains(QLatin1String("://")))
@@ -326,7 +348,7 @@ void WebApplication::configure()
     {
         m_isAltUIUsed = isAltUIUsed;
         m_rootFolder = rootFolder;
-        m_translatedFiles.clear();
+        m_cachedFiles.clear();
         if (!m_isAltUIUsed)
             LogMsg(tr("Using built-in Web UI."));
         else
@@ -337,7 +359,7 @@ void WebApplication::configure()
     if (m_currentLocale != newLocale)
     {
         m_currentLocale = newLocale;
-        m_translatedFiles.clear();
+        m_cachedFiles.clear();
 
         m_translationFileLoaded = m_translator.load(m_rootFolder + QLatin1String("/translations/webui_") + newLocale);
         if (m_translationFileLoaded)
@@ -441,47 +463,64 @@ void WebApplication::sendFile(const QString &path)
 {
     const QDateTime lastModified {QFileInfo(path).lastModified()};
 
-    // find translated file in cache
-    const auto it = m_translatedFiles.constFind(path);
-    if ((it != m_translatedFiles.constEnd()) && (lastModified <= it->lastModified))
+    // find file in cache
+    auto it = m_cachedFiles.constFind(path);
+    if ((it == m_cachedFiles.constEnd()) || (lastModified > it->lastModified))
     {
-        print(it->data, it->mimeType);
-        setHeader({Http::HEADER_CACHE_CONTROL, getCachingInterval(it->mimeType)});
-        return;
-    }
+        QFile file {path};
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            qDebug("File %s was not found!", qUtf8Printable(path));
+            throw NotFoundHTTPError();
+        }
 
-    QFile file {path};
-    if (!file.open(QIODevice::ReadOnly))
-    {
-        qDebug("File %s was not found!", qUtf8Printable(path));
-        throw NotFoundHTTPError();
-    }
+        if (file.size() > MAX_ALLOWED_FILESIZE)
+        {
+            qWarning("%s: exceeded the maximum allowed file size!", qUtf8Printable(path));
+            throw InternalServerErrorHTTPError(tr("Exceeded the maximum allowed file size (%1)!")
+                                               .arg(Utils::Misc::friendlyUnit(MAX_ALLOWED_FILESIZE)));
+        }
 
-    if (file.size() > MAX_ALLOWED_FILESIZE)
-    {
-        qWarning("%s: exceeded the maximum allowed file size!", qUtf8Printable(path));
-        throw InternalServerErrorHTTPError(tr("Exceeded the maximum allowed file size (%1)!")
-                                           .arg(Utils::Misc::friendlyUnit(MAX_ALLOWED_FILESIZE)));
-    }
+        QByteArray data {file.readAll()};
+        file.close();
 
-    QByteArray data {file.readAll()};
-    file.close();
+        const QMimeType mimeType {QMimeDatabase().mimeTypeForFileNameAndData(path, data)};
+        const bool isTranslatable {mimeType.inherits(QLatin1String("text/plain"))};
 
-    const QMimeType mimeType {QMimeDatabase().mimeTypeForFileNameAndData(path, data)};
-    const bool isTranslatable {mimeType.inherits(QLatin1String("text/plain"))};
+        // Translate the file
+        if (isTranslatable)
+        {
+            QString dataStr {data};
+            translateDocument(dataStr);
+            data = dataStr.toUtf8();
+        }
 
-    // Translate the file
-    if (isTranslatable)
-    {
-        QString dataStr {data};
-        translateDocument(dataStr);
-        data = dataStr.toUtf8();
+        // caching the file along with its compressed variant so it is compressed only once
+        const QByteArray gzipData = Http::compressContent(data, mimeType.name(), 9);
+        const QString hash = QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+        const QString etag = QLatin1Char('"') + hash + QLatin1Char('"');
+        // entity tag of gzip encoded content has suffix appended
+        const QString gzipETag = QLatin1Char('"') + hash + QLatin1String(Http::GZIP_ETAG_SUFFIX) + QLatin1Char('"');
+        it = m_cachedFiles.insert(path, {data, gzipData, mimeType.name(), etag, gzipETag, lastModified});
+    }
 
-        m_translatedFiles[path] = {data, mimeType.name(), lastModified}; // caching translated file
+    setHeader({Http::HEADER_CACHE_CONTROL, getCachingInterval(it->mimeType)});
+
+    // [rfc7232] 4.1. 304 Not Modified must contain the ETag of the representation that would be sent
+    const bool isGzipSelected = !it->gzipData.isEmpty()
+        && Http::acceptsGzipEncoding(request().headers.value(Http::HEADER_ACCEPT_ENCODING));
+    const QString &selectedETag = isGzipSelected ? it->gzipETag : it->etag;
+    if (matchesETag(request().headers.value(Http::HEADER_IF_NONE_MATCH), selectedETag))
+    {
+        setHeader({Http::HEADER_ETAG, selectedETag});
+        status(304, QLatin1String("Not Modified"));
+        return;
     }
 
-    print(data, mimeType.name());
-    setHeader({Http::HEADER_CACHE_CONTROL, getCachingInterval(mimeType.name())});
+    // suffix is appended to the ETag when the compressed content is sent
+    setHeader({Http::HEADER_ETAG, it->etag});
+    print(it->data, it->mimeType);
+    setGzipContent(it->gzipData);
 }
 
 Http::Response WebApplication::processRequest(const Http::Request &request, const Http::Environment &env)
@@ -43,7 +43,7 @@
 #include "base/utils/net.h"
 #include "base/utils/version.h"
 
-inline const Utils::Version<int, 3, 2> API_VERSION {2, 8, 3};
+inline const Utils::Version<int, 3, 2> API_VERSION {2, 8, 5};
 
 class APIController;
 class WebApplication;
@@ -133,13 +133,16 @@ private:
     bool m_isAltUIUsed = false;
     QString m_rootFolder;
 
-    struct TranslatedFile
+    struct CachedFile
     {
         QByteArray data;
+        QByteArray gzipData;
         QString mimeType;
+        QString etag;
+        QString gzipETag;
         QDateTime lastModified;
     };
-    QHash<QString, TranslatedFile> m_translatedFiles;
+    QHash<QString, CachedFile> m_cachedFiles;
     QString m_currentLocale;
     QTranslator m_translator;
     bool m_translationFileLoaded = false;
@@ -10,6 +10,7 @@ HEADERS += \
     $$PWD/api/searchcontroller.h \
     $$PWD/api/synccontroller.h \
     $$PWD/api/torrentscontroller.h \
+    $$PWD/api/torrentssnapshot.h \
     $$PWD/api/transfercontroller.h \
     $$PWD/api/serialize/serialize_torrent.h \
     $$PWD/webapplication.h \
@@ -26,6 +27,7 @@ SOURCES += \
     $$PWD/api/searchcontroller.cpp \
     $$PWD/api/synccontroller.cpp \
     $$PWD/api/torrentscontroller.cpp \
+    $$PWD/api/torrentssnapshot.cpp \
     $$PWD/api/transfercontroller.cpp \
     $$PWD/api/serialize/serialize_torrent.cpp \
     $$PWD/webapplication.cpp \
@@ -147,6 +147,18 @@ window.qBittorrent.FileTree = (function() {
          * Recursively calculate size of node and its children
          */
         calculateSize: function() {
+            this.children.each(function(node) {
+                if (node.isFolder)
+                    node.calculateSize();
+            });
+
+            this.updateFromChildren();
+        },
+
+        /**
+         * Calculate size of node from the current values of its children
+         */
+        updateFromChildren: function() {
             let size = 0;
             let remaining = 0;
             let progress = 0;
@@ -157,9 +169,6 @@ window.qBittorrent.FileTree = (function() {
             let isFirstFile = true;
 
             this.children.each(function(node) {
-                if (node.isFolder)
-                    node.calculateSize();
-
                 size += node.size;
 
                 if (isFirstFile) {
@@ -52,6 +52,8 @@ window.qBittorrent.PropFiles = (function() {
     const TriState = window.qBittorrent.FileTree.TriState;
     let is_seed = true;
     let current_hash = "";
+    // File nodes of the current tree, indexed by file index
+    let fileNodes = [];
 
     const normalizePriority = function(priority) {
         switch (priority) {
@@ -346,6 +348,7 @@ window.qBittorrent.PropFiles = (function() {
         const new_hash = torrentsTable.getCurrentTorrentID();
         if (new_hash === "") {
             torrentFilesTable.clear();
+            fileNodes = [];
             clearTimeout(loadTorrentFilesDataTimer);
             loadTorrentFilesDataTimer = loadTorrentFilesData.delay(5000);
             return;
@@ -353,6 +356,7 @@ window.qBittorrent.PropFiles = (function() {
         let loadedNewTorrent = false;
         if (new_hash != current_hash) {
             torrentFilesTable.clear();
+            fileNodes = [];
             current_hash = new_hash;
             loadedNewTorrent = true;
         }
@@ -370,6 +374,7 @@ window.qBittorrent.PropFiles = (function() {
 
                 if (files.length === 0) {
                     torrentFilesTable.clear();
+                    fileNodes = [];
                 }
                 else {
                     handleNewTorrentFiles(files);
@@ -411,13 +416,77 @@ window.qBittorrent.PropFiles = (function() {
             return row;
         });
 
-        addRowsToTable(rows);
+        if (canUpdateFilesInPlace(rows))
+            updateFilesInPlace(rows);
+        else
+            addRowsToTable(rows);
         updateGlobalCheckbox();
     };
 
+    const canUpdateFilesInPlace = function(rows) {
+        if (fileNodes.length !== rows.length)
+            return false;
+
+        return rows.every(function(row, index) {
+            return (fileNodes[index].path === row.fileName);
+        });
+    };
+
+    // Updates only the files whose values changed and the folders containing them
+    const updateFilesInPlace = function(rows) {
+        const changedFolders = new Set();
+
+        rows.forEach(function(row) {
+            const node = fileNodes[row.fileId];
+            const isChecked = row.checked ? TriState.Checked : TriState.Unchecked;
+            const remaining = (row.priority === FilePriority.Ignored) ? 0 : row.remaining;
+            if ((node.checked === isChecked)
+                && (node.remaining === remaining)
+                && (node.progress === row.progress)
+                && (node.priority === row.priority)
+                && (node.availability === row.availability))
+                return;
+
+            node.checked = isChecked;
+            node.remaining = remaining;
+            node.progress = row.progress;
+            node.priority = row.priority;
+            node.availability = row.availability;
+
+            row.rowId = node.rowId;
+            node.data = row;
+            node.full_data = row;
+            torrentFilesTable.updateRowData(row);
+
+            for (let folder = node.root; folder.root !== null; folder = folder.root) {
+                if (changedFolders.has(folder))
+                    break;
+                changedFolders.add(folder);
+            }
+        });
+
+        // update nested folders before their parents
+        const folders = Array.from(changedFolders).sort(function(folder1, folder2) {
+            return (folder2.depth - folder1.depth);
+        });
+        folders.forEach(function(folder) {
+            folder.updateFromChildren();
+
+            folder.data.checked = folder.checked;
+            folder.data.remaining = folder.remaining;
+            folder.data.progress = folder.progress;
+            folder.data.priority = normalizePriority(folder.priority);
+            folder.data.availability = folder.availability;
+            torrentFilesTable.updateRowData(folder.data);
+        });
+
+        torrentFilesTable.updateTable(false);
+    };
+
     const addRowsToTable = function(rows) {
         const selectedFiles = torrentFilesTable.selectedRowsIds();
         let rowId = 0;
+        fileNodes = [];
 
         const rootNode = new window.qBittorrent.FileTree.FolderNode();
 
@@ -472,6 +541,7 @@ window.qBittorrent.PropFiles = (function() {
             childNode.root = parent;
             childNode.data = row;
             parent.addChild(childNode);
+            fileNodes[row.fileId] = childNode;
 
             ++rowId;
         }.bind(this));